@@ -0,0 +1,9 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/libsdd
+# Build directory: /root/repo/libsdd/_gate_build_dbg
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("sdd")
+subdirs("examples")
+subdirs("tests")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/dictionary.dir/dictionary.cc.o"
+  "CMakeFiles/dictionary.dir/dictionary.cc.o.d"
+  "dictionary"
+  "dictionary.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/dictionary.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
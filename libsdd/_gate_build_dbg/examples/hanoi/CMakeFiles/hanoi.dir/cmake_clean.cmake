@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hanoi.dir/hanoi.cc.o"
+  "CMakeFiles/hanoi.dir/hanoi.cc.o.d"
+  "hanoi"
+  "hanoi.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hanoi.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,61 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/libsdd/tests/dd/test_count_combinations.cc" "tests/CMakeFiles/tests.dir/dd/test_count_combinations.cc.o" "gcc" "tests/CMakeFiles/tests.dir/dd/test_count_combinations.cc.o.d"
+  "/root/repo/libsdd/tests/dd/test_definition.cc" "tests/CMakeFiles/tests.dir/dd/test_definition.cc.o" "gcc" "tests/CMakeFiles/tests.dir/dd/test_definition.cc.o.d"
+  "/root/repo/libsdd/tests/dd/test_difference.cc" "tests/CMakeFiles/tests.dir/dd/test_difference.cc.o" "gcc" "tests/CMakeFiles/tests.dir/dd/test_difference.cc.o.d"
+  "/root/repo/libsdd/tests/dd/test_difference_sum.cc" "tests/CMakeFiles/tests.dir/dd/test_difference_sum.cc.o" "gcc" "tests/CMakeFiles/tests.dir/dd/test_difference_sum.cc.o.d"
+  "/root/repo/libsdd/tests/dd/test_intersection.cc" "tests/CMakeFiles/tests.dir/dd/test_intersection.cc.o" "gcc" "tests/CMakeFiles/tests.dir/dd/test_intersection.cc.o.d"
+  "/root/repo/libsdd/tests/dd/test_parallel.cc" "tests/CMakeFiles/tests.dir/dd/test_parallel.cc.o" "gcc" "tests/CMakeFiles/tests.dir/dd/test_parallel.cc.o.d"
+  "/root/repo/libsdd/tests/dd/test_path_generator.cc" "tests/CMakeFiles/tests.dir/dd/test_path_generator.cc.o" "gcc" "tests/CMakeFiles/tests.dir/dd/test_path_generator.cc.o.d"
+  "/root/repo/libsdd/tests/dd/test_sum.cc" "tests/CMakeFiles/tests.dir/dd/test_sum.cc.o" "gcc" "tests/CMakeFiles/tests.dir/dd/test_sum.cc.o.d"
+  "/root/repo/libsdd/tests/dd/test_top.cc" "tests/CMakeFiles/tests.dir/dd/test_top.cc.o" "gcc" "tests/CMakeFiles/tests.dir/dd/test_top.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_composition.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_composition.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_composition.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_cons.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_cons.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_cons.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_fixpoint.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_fixpoint.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_fixpoint.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_function.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_function.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_function.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_identity.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_identity.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_identity.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_if_then_else.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_if_then_else.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_if_then_else.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_inductive.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_inductive.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_inductive.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_interrupt.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_interrupt.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_interrupt.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_local.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_local.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_local.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_parallel.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_parallel.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_parallel.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_saturation_fixpoint.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_saturation_fixpoint.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_saturation_fixpoint.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_saturation_sum.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_saturation_sum.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_saturation_sum.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_hom_sum.cc" "tests/CMakeFiles/tests.dir/hom/test_hom_sum.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_hom_sum.cc.o.d"
+  "/root/repo/libsdd/tests/hom/test_rewriting.cc" "tests/CMakeFiles/tests.dir/hom/test_rewriting.cc.o" "gcc" "tests/CMakeFiles/tests.dir/hom/test_rewriting.cc.o.d"
+  "/root/repo/libsdd/tests/mem/test_cache.cc" "tests/CMakeFiles/tests.dir/mem/test_cache.cc.o" "gcc" "tests/CMakeFiles/tests.dir/mem/test_cache.cc.o.d"
+  "/root/repo/libsdd/tests/mem/test_hash_table.cc" "tests/CMakeFiles/tests.dir/mem/test_hash_table.cc.o" "gcc" "tests/CMakeFiles/tests.dir/mem/test_hash_table.cc.o.d"
+  "/root/repo/libsdd/tests/mem/test_ptr.cc" "tests/CMakeFiles/tests.dir/mem/test_ptr.cc.o" "gcc" "tests/CMakeFiles/tests.dir/mem/test_ptr.cc.o.d"
+  "/root/repo/libsdd/tests/mem/test_slab_allocator.cc" "tests/CMakeFiles/tests.dir/mem/test_slab_allocator.cc.o" "gcc" "tests/CMakeFiles/tests.dir/mem/test_slab_allocator.cc.o.d"
+  "/root/repo/libsdd/tests/mem/test_unique_table.cc" "tests/CMakeFiles/tests.dir/mem/test_unique_table.cc.o" "gcc" "tests/CMakeFiles/tests.dir/mem/test_unique_table.cc.o.d"
+  "/root/repo/libsdd/tests/mem/test_variant.cc" "tests/CMakeFiles/tests.dir/mem/test_variant.cc.o" "gcc" "tests/CMakeFiles/tests.dir/mem/test_variant.cc.o.d"
+  "/root/repo/libsdd/tests/order/test_carrier.cc" "tests/CMakeFiles/tests.dir/order/test_carrier.cc.o" "gcc" "tests/CMakeFiles/tests.dir/order/test_carrier.cc.o.d"
+  "/root/repo/libsdd/tests/order/test_order.cc" "tests/CMakeFiles/tests.dir/order/test_order.cc.o" "gcc" "tests/CMakeFiles/tests.dir/order/test_order.cc.o.d"
+  "/root/repo/libsdd/tests/order/test_order_strategy.cc" "tests/CMakeFiles/tests.dir/order/test_order_strategy.cc.o" "gcc" "tests/CMakeFiles/tests.dir/order/test_order_strategy.cc.o.d"
+  "/root/repo/libsdd/tests/order/test_utility.cc" "tests/CMakeFiles/tests.dir/order/test_utility.cc.o" "gcc" "tests/CMakeFiles/tests.dir/order/test_utility.cc.o.d"
+  "/root/repo/libsdd/tests/tests.cc" "tests/CMakeFiles/tests.dir/tests.cc.o" "gcc" "tests/CMakeFiles/tests.dir/tests.cc.o.d"
+  "/root/repo/libsdd/tests/tools/test_arcs.cc" "tests/CMakeFiles/tests.dir/tools/test_arcs.cc.o" "gcc" "tests/CMakeFiles/tests.dir/tools/test_arcs.cc.o.d"
+  "/root/repo/libsdd/tests/tools/test_nodes.cc" "tests/CMakeFiles/tests.dir/tools/test_nodes.cc.o" "gcc" "tests/CMakeFiles/tests.dir/tools/test_nodes.cc.o.d"
+  "/root/repo/libsdd/tests/util/test_next_power.cc" "tests/CMakeFiles/tests.dir/util/test_next_power.cc.o" "gcc" "tests/CMakeFiles/tests.dir/util/test_next_power.cc.o.d"
+  "/root/repo/libsdd/tests/util/test_typelist.cc" "tests/CMakeFiles/tests.dir/util/test_typelist.cc.o" "gcc" "tests/CMakeFiles/tests.dir/util/test_typelist.cc.o.d"
+  "/root/repo/libsdd/tests/values/test_bitset.cc" "tests/CMakeFiles/tests.dir/values/test_bitset.cc.o" "gcc" "tests/CMakeFiles/tests.dir/values/test_bitset.cc.o.d"
+  "/root/repo/libsdd/tests/values/test_flat_set.cc" "tests/CMakeFiles/tests.dir/values/test_flat_set.cc.o" "gcc" "tests/CMakeFiles/tests.dir/values/test_flat_set.cc.o.d"
+  "/root/repo/libsdd/tests/values/test_roaring.cc" "tests/CMakeFiles/tests.dir/values/test_roaring.cc.o" "gcc" "tests/CMakeFiles/tests.dir/values/test_roaring.cc.o.d"
+  "/root/repo/libsdd/tests/values/test_wide_bitset.cc" "tests/CMakeFiles/tests.dir/values/test_wide_bitset.cc.o" "gcc" "tests/CMakeFiles/tests.dir/values/test_wide_bitset.cc.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/libsdd/_gate_build_dbg/tests/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
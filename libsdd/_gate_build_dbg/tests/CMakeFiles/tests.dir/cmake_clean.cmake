@@ -0,0 +1,93 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tests.dir/dd/test_count_combinations.cc.o"
+  "CMakeFiles/tests.dir/dd/test_count_combinations.cc.o.d"
+  "CMakeFiles/tests.dir/dd/test_definition.cc.o"
+  "CMakeFiles/tests.dir/dd/test_definition.cc.o.d"
+  "CMakeFiles/tests.dir/dd/test_difference.cc.o"
+  "CMakeFiles/tests.dir/dd/test_difference.cc.o.d"
+  "CMakeFiles/tests.dir/dd/test_difference_sum.cc.o"
+  "CMakeFiles/tests.dir/dd/test_difference_sum.cc.o.d"
+  "CMakeFiles/tests.dir/dd/test_intersection.cc.o"
+  "CMakeFiles/tests.dir/dd/test_intersection.cc.o.d"
+  "CMakeFiles/tests.dir/dd/test_parallel.cc.o"
+  "CMakeFiles/tests.dir/dd/test_parallel.cc.o.d"
+  "CMakeFiles/tests.dir/dd/test_path_generator.cc.o"
+  "CMakeFiles/tests.dir/dd/test_path_generator.cc.o.d"
+  "CMakeFiles/tests.dir/dd/test_sum.cc.o"
+  "CMakeFiles/tests.dir/dd/test_sum.cc.o.d"
+  "CMakeFiles/tests.dir/dd/test_top.cc.o"
+  "CMakeFiles/tests.dir/dd/test_top.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_composition.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_composition.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_cons.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_cons.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_fixpoint.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_fixpoint.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_function.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_function.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_identity.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_identity.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_if_then_else.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_if_then_else.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_inductive.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_inductive.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_interrupt.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_interrupt.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_local.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_local.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_parallel.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_parallel.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_saturation_fixpoint.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_saturation_fixpoint.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_saturation_sum.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_saturation_sum.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_hom_sum.cc.o"
+  "CMakeFiles/tests.dir/hom/test_hom_sum.cc.o.d"
+  "CMakeFiles/tests.dir/hom/test_rewriting.cc.o"
+  "CMakeFiles/tests.dir/hom/test_rewriting.cc.o.d"
+  "CMakeFiles/tests.dir/mem/test_cache.cc.o"
+  "CMakeFiles/tests.dir/mem/test_cache.cc.o.d"
+  "CMakeFiles/tests.dir/mem/test_hash_table.cc.o"
+  "CMakeFiles/tests.dir/mem/test_hash_table.cc.o.d"
+  "CMakeFiles/tests.dir/mem/test_ptr.cc.o"
+  "CMakeFiles/tests.dir/mem/test_ptr.cc.o.d"
+  "CMakeFiles/tests.dir/mem/test_slab_allocator.cc.o"
+  "CMakeFiles/tests.dir/mem/test_slab_allocator.cc.o.d"
+  "CMakeFiles/tests.dir/mem/test_unique_table.cc.o"
+  "CMakeFiles/tests.dir/mem/test_unique_table.cc.o.d"
+  "CMakeFiles/tests.dir/mem/test_variant.cc.o"
+  "CMakeFiles/tests.dir/mem/test_variant.cc.o.d"
+  "CMakeFiles/tests.dir/order/test_carrier.cc.o"
+  "CMakeFiles/tests.dir/order/test_carrier.cc.o.d"
+  "CMakeFiles/tests.dir/order/test_order.cc.o"
+  "CMakeFiles/tests.dir/order/test_order.cc.o.d"
+  "CMakeFiles/tests.dir/order/test_order_strategy.cc.o"
+  "CMakeFiles/tests.dir/order/test_order_strategy.cc.o.d"
+  "CMakeFiles/tests.dir/order/test_utility.cc.o"
+  "CMakeFiles/tests.dir/order/test_utility.cc.o.d"
+  "CMakeFiles/tests.dir/tests.cc.o"
+  "CMakeFiles/tests.dir/tests.cc.o.d"
+  "CMakeFiles/tests.dir/tools/test_arcs.cc.o"
+  "CMakeFiles/tests.dir/tools/test_arcs.cc.o.d"
+  "CMakeFiles/tests.dir/tools/test_nodes.cc.o"
+  "CMakeFiles/tests.dir/tools/test_nodes.cc.o.d"
+  "CMakeFiles/tests.dir/util/test_next_power.cc.o"
+  "CMakeFiles/tests.dir/util/test_next_power.cc.o.d"
+  "CMakeFiles/tests.dir/util/test_typelist.cc.o"
+  "CMakeFiles/tests.dir/util/test_typelist.cc.o.d"
+  "CMakeFiles/tests.dir/values/test_bitset.cc.o"
+  "CMakeFiles/tests.dir/values/test_bitset.cc.o.d"
+  "CMakeFiles/tests.dir/values/test_flat_set.cc.o"
+  "CMakeFiles/tests.dir/values/test_flat_set.cc.o.d"
+  "CMakeFiles/tests.dir/values/test_roaring.cc.o"
+  "CMakeFiles/tests.dir/values/test_roaring.cc.o.d"
+  "CMakeFiles/tests.dir/values/test_wide_bitset.cc.o"
+  "CMakeFiles/tests.dir/values/test_wide_bitset.cc.o.d"
+  "tests"
+  "tests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/libsdd/tests
+# Build directory: /root/repo/libsdd/_gate_build_dbg/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(UnitTests "tests")
+set_tests_properties(UnitTests PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/libsdd/tests/CMakeLists.txt;54;add_test;/root/repo/libsdd/tests/CMakeLists.txt;0;")
@@ -6,11 +6,20 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstdint> // uint16_t, uint32_t
 #include <string>
 
+#include "sdd/hom/fixpoint_strategy.hh"
+#include "sdd/mem/cache.hh"
+#include "sdd/mem/concurrent_cache.hh"
+#include "sdd/mem/sharded_unique_table.hh"
+#include "sdd/mem/unique_table.hh"
+#include "sdd/util/typelist.hh"
 #include "sdd/values/bitset.hh"
 #include "sdd/values/flat_set.hh"
+#include "sdd/values/roaring.hh"
+#include "sdd/values/wide_bitset.hh"
 
 namespace sdd {
 
@@ -31,12 +40,59 @@ struct default_configuration
   /// @brief The type to store the number of elements in an operation.
   using operands_size_type = std::uint32_t;
 
+  /// @brief The type of the reference counter of unified SDD and homomorphisms.
+  using reference_counter_type = std::uint32_t;
+
+  /// @brief The type of the table which unifies SDD and homomorphisms.
+  ///
+  /// mem::unique_table<Unique, true> rehashes incrementally, which bounds the cost of each
+  /// unification at the price of a slightly slower lookup while the table grows.
+  template <typename Unique>
+  using unique_table_type = mem::unique_table<Unique>;
+
+  /// @brief The type of the caches of SDD operations and homomorphisms.
+  ///
+  /// A derived configuration can select another eviction policy with
+  /// mem::basic_cache<Context, Operation, mem::clock_eviction, Filters...>.
+  template <typename Context, typename Operation, typename... Filters>
+  using cache_type = mem::cache<Context, Operation, Filters...>;
+
+  /// @brief The types of user's inductive homomorphisms known at compile time.
+  ///
+  /// Inductive homomorphisms of these types are stored directly in homomorphisms, and calls to
+  /// them are not virtual. For instance, util::list<my_inductive<my_conf>>.
+  using inductive_types = util::list<>;
+
+  /// @brief The types of user's functions known at compile time.
+  ///
+  /// Function homomorphisms of these types are stored directly in homomorphisms, and calls to
+  /// them are not virtual.
+  using function_types = util::list<>;
+
+  /// @brief Tell if SDD and homomorphisms can be shared by several threads.
+  static constexpr bool thread_safe = false;
+
+  /// @brief Tell if nodes store their successors and their valuations in two separate arrays.
+  ///
+  /// Traversals which only follow successors then don't load valuations. Otherwise, nodes store
+  /// an array of arcs, which is better when both valuations and successors are visited.
+  static constexpr bool split_alpha = false;
+
   /// @brief The initial size of the hash table that stores SDD.
   std::size_t sdd_unique_table_size;
 
+  /// @brief The number of unreferenced SDD kept in the unique table before they are collected.
+  ///
+  /// An unreferenced SDD which is built again before its collection is reused. 0 destroys an SDD
+  /// as soon as it's no longer referenced. It's not used by thread-safe configurations.
+  std::size_t sdd_collection_threshold;
+
   /// @brief The size of the cache of SDD difference operations.
   std::size_t sdd_difference_cache_size;
 
+  /// @brief The size of the cache of SDD fused (lhs - rhs) + addend operations.
+  std::size_t sdd_difference_sum_cache_size;
+
   /// @brief The size of the cache of SDD intersection operations.
   std::size_t sdd_intersection_cache_size;
 
@@ -46,37 +102,99 @@ struct default_configuration
   /// @brief The size, in bytes, of the buffer for temporary containers allocation.
   std::size_t sdd_arena_size;
 
+  /// @brief The number of threads used to evaluate SDD operations.
+  ///
+  /// A value greater than 1 requires a thread-safe configuration (see concurrent_configuration).
+  std::size_t sdd_nb_threads;
+
+  /// @brief The minimal number of independent sub-operations to evaluate them in parallel.
+  std::size_t sdd_parallel_threshold;
+
   /// @brief The initial size of the hash table that stores homomorphisms.
   std::size_t hom_unique_table_size;
 
   /// @brief The size of the cache of homomorphism applications.
   std::size_t hom_cache_size;
 
+  /// @brief How Fixpoint and Saturation Fixpoint homomorphisms are evaluated.
+  fixpoint_strategy hom_fixpoint_strategy;
+
+  /// @brief The maximal number of images of values cached by each Function homomorphism.
+  ///
+  /// 0 disables these caches.
+  std::size_t hom_function_cache_size;
+
   /// @brief Default constructor.
   ///
   /// Initialize all parameters to their default values.
   default_configuration()
     : sdd_unique_table_size(10'000'000)
+    , sdd_collection_threshold(0)
     , sdd_difference_cache_size(500'000)
+    , sdd_difference_sum_cache_size(500'000)
     , sdd_intersection_cache_size(500'000)
     , sdd_sum_cache_size(1'000'000)
     , sdd_arena_size(1024*1024*16)
+    , sdd_nb_threads(1)
+    , sdd_parallel_threshold(64)
     , hom_unique_table_size(1'000'000)
     , hom_cache_size(1'000'000)
+    , hom_fixpoint_strategy(fixpoint_strategy::accumulate)
+    , hom_function_cache_size(1024)
   {}
 };
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @brief A base configuration to share SDD and homomorphisms between several threads.
+///
+/// Unified SDD and homomorphisms are stored in sharded tables and their reference counters are
+/// atomic. Operations and homomorphisms are cached in lossy concurrent caches. It should be used
+/// with values types that don't need to be unified (like bitset), as flat_set relies on a table
+/// which is not thread-safe.
+struct concurrent_configuration
+  : public default_configuration
+{
+  using reference_counter_type = std::atomic<std::uint32_t>;
+
+  template <typename Unique>
+  using unique_table_type = mem::sharded_unique_table<Unique>;
+
+  template <typename Context, typename Operation, typename... Filters>
+  using cache_type = mem::concurrent_cache<Context, Operation, Filters...>;
+
+  static constexpr bool thread_safe = true;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 struct flat_set_default_configuration
   : public default_configuration
 {
   /// @brief The size of the hash table that stores flat_set<>.
   std::size_t flat_set_unique_table_size;
 
+  /// @brief The size of the cache of operations on flat_set<>.
+  std::size_t flat_set_cache_size;
+
   flat_set_default_configuration()
     : default_configuration()
     , flat_set_unique_table_size(5000)
+    , flat_set_cache_size(10000)
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct roaring_default_configuration
+  : public default_configuration
+{
+  /// @brief The size of the hash table that stores roaring.
+  std::size_t roaring_unique_table_size;
+
+  roaring_default_configuration()
+    : default_configuration()
+    , roaring_unique_table_size(5000)
   {}
 };
 
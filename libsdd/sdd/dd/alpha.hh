@@ -6,6 +6,11 @@
 
 #pragma once
 
+#include <algorithm>   // equal
+#include <cstddef>     // ptrdiff_t
+#include <iterator>    // random_access_iterator_tag
+#include <type_traits> // conditional_t
+
 #include <boost/container/flat_map.hpp>
 
 #include "sdd/dd/context_fwd.hh"
@@ -57,6 +62,25 @@ public:
     return successor_;
   }
 
+  /// @internal
+  /// @brief Tell if this arc has a given valuation and a given successor.
+  bool
+  equal(const Valuation& val, const SDD<C>& succ)
+  const noexcept
+  {
+    return successor_ == succ and valuation_ == val;
+  }
+
+  /// @internal
+  /// @brief Compute the hash value of an arc from its valuation and its successor.
+  static
+  std::size_t
+  hash(const Valuation& valuation, const SDD<C>& successor)
+  {
+    using namespace sdd::hash;
+    return seed(valuation) (val(successor));
+  }
+
   /// @brief Equality of two arcs.
   friend
   bool
@@ -69,8 +93,379 @@ public:
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @brief Represent an arc of an alpha whose successors and valuations are stored apart.
+///
+/// It's what iterating on a node gives when the configuration sets split_alpha. Successors and
+/// valuations are only loaded when requested.
+template <typename C, typename Valuation>
+class arc_reference final
+{
+private:
+
+  /// @brief This arc's valuation, either an SDD or a set of values.
+  const Valuation* valuation_;
+
+  /// @brief This arcs's SDD successor.
+  const SDD<C>* successor_;
+
+public:
+
+  /// @brief The valuation type.
+  using valuation_type = Valuation;
+
+  /// @internal
+  /// @brief Constructor.
+  arc_reference(const Valuation* val, const SDD<C>* succ)
+  noexcept
+    : valuation_(val)
+    , successor_(succ)
+  {}
+
+  /// @brief Get the valuation of this arc.
+  const Valuation&
+  valuation()
+  const noexcept
+  {
+    return *valuation_;
+  }
+
+  /// @brief Get the successor of this arc.
+  SDD<C>
+  successor()
+  const noexcept
+  {
+    return *successor_;
+  }
+
+  /// @internal
+  /// @brief Tell if this arc has a given valuation and a given successor.
+  bool
+  equal(const Valuation& val, const SDD<C>& succ)
+  const noexcept
+  {
+    return *successor_ == succ and *valuation_ == val;
+  }
+
+  /// @brief Equality of two arcs.
+  friend
+  bool
+  operator==(const arc_reference& lhs, const arc_reference& rhs)
+  noexcept
+  {
+    return *lhs.successor_ == *rhs.successor_ and *lhs.valuation_ == *rhs.valuation_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 namespace dd {
 
+/// @internal
+/// @brief Iterate on the arcs of an alpha whose successors and valuations are stored apart.
+template <typename C, typename Valuation>
+class split_arc_iterator
+{
+public:
+
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type        = arc_reference<C, Valuation>;
+  using difference_type   = std::ptrdiff_t;
+  using reference         = arc_reference<C, Valuation>;
+
+  /// @brief Give access to the members of a temporary arc_reference.
+  struct pointer
+  {
+    const reference ref;
+
+    const reference*
+    operator->()
+    const noexcept
+    {
+      return &ref;
+    }
+  };
+
+private:
+
+  const SDD<C>* successor_;
+  const Valuation* valuation_;
+
+public:
+
+  split_arc_iterator(const SDD<C>* succ, const Valuation* val)
+  noexcept
+    : successor_(succ), valuation_(val)
+  {}
+
+  reference
+  operator*()
+  const noexcept
+  {
+    return {valuation_, successor_};
+  }
+
+  pointer
+  operator->()
+  const noexcept
+  {
+    return {**this};
+  }
+
+  reference
+  operator[](difference_type n)
+  const noexcept
+  {
+    return {valuation_ + n, successor_ + n};
+  }
+
+  split_arc_iterator&
+  operator++()
+  noexcept
+  {
+    ++successor_;
+    ++valuation_;
+    return *this;
+  }
+
+  split_arc_iterator
+  operator++(int)
+  noexcept
+  {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  split_arc_iterator&
+  operator--()
+  noexcept
+  {
+    --successor_;
+    --valuation_;
+    return *this;
+  }
+
+  split_arc_iterator
+  operator--(int)
+  noexcept
+  {
+    auto tmp = *this;
+    --*this;
+    return tmp;
+  }
+
+  split_arc_iterator&
+  operator+=(difference_type n)
+  noexcept
+  {
+    successor_ += n;
+    valuation_ += n;
+    return *this;
+  }
+
+  split_arc_iterator&
+  operator-=(difference_type n)
+  noexcept
+  {
+    return *this += -n;
+  }
+
+  friend
+  split_arc_iterator
+  operator+(split_arc_iterator it, difference_type n)
+  noexcept
+  {
+    return it += n;
+  }
+
+  friend
+  split_arc_iterator
+  operator-(split_arc_iterator it, difference_type n)
+  noexcept
+  {
+    return it -= n;
+  }
+
+  friend
+  difference_type
+  operator-(const split_arc_iterator& lhs, const split_arc_iterator& rhs)
+  noexcept
+  {
+    return lhs.successor_ - rhs.successor_;
+  }
+
+  friend
+  bool
+  operator==(const split_arc_iterator& lhs, const split_arc_iterator& rhs)
+  noexcept
+  {
+    return lhs.successor_ == rhs.successor_;
+  }
+
+  friend
+  bool
+  operator!=(const split_arc_iterator& lhs, const split_arc_iterator& rhs)
+  noexcept
+  {
+    return not (lhs == rhs);
+  }
+
+  friend
+  bool
+  operator<(const split_arc_iterator& lhs, const split_arc_iterator& rhs)
+  noexcept
+  {
+    return lhs.successor_ < rhs.successor_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Store an alpha right behind its node as an array of arcs.
+template <typename C, typename Valuation>
+struct interleaved_layout
+{
+  using const_iterator = const arc<C, Valuation>*;
+
+  static
+  std::size_t
+  size_to_allocate(std::size_t size)
+  noexcept
+  {
+    return size * sizeof(arc<C, Valuation>);
+  }
+
+  /// @brief Construct the i-th arc of an alpha of a given size.
+  static
+  void
+  construct(char* addr, std::size_t, std::size_t i, Valuation&& val, SDD<C>&& succ)
+  noexcept
+  {
+    new (reinterpret_cast<arc<C, Valuation>*>(addr) + i)
+      arc<C, Valuation>(std::move(val), std::move(succ));
+  }
+
+  static
+  void
+  destroy(char* addr, std::size_t size)
+  noexcept
+  {
+    auto base = reinterpret_cast<arc<C, Valuation>*>(addr);
+    for (auto a = base; a != base + size; ++a)
+    {
+      a->~arc<C, Valuation>();
+    }
+  }
+
+  static
+  const_iterator
+  begin(const char* addr, std::size_t)
+  noexcept
+  {
+    return reinterpret_cast<const arc<C, Valuation>*>(addr);
+  }
+
+  static
+  const_iterator
+  end(const char* addr, std::size_t size)
+  noexcept
+  {
+    return reinterpret_cast<const arc<C, Valuation>*>(addr) + size;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Store an alpha right behind its node as an array of successors followed by an array of
+/// valuations.
+///
+/// Traversals which only follow successors, like the computation of the number of nodes, don't
+/// load valuations.
+template <typename C, typename Valuation>
+struct split_layout
+{
+  using const_iterator = split_arc_iterator<C, Valuation>;
+
+  static
+  std::size_t
+  size_to_allocate(std::size_t size)
+  noexcept
+  {
+    return size * (sizeof(SDD<C>) + sizeof(Valuation));
+  }
+
+  /// @brief Construct the i-th arc of an alpha of a given size.
+  static
+  void
+  construct(char* addr, std::size_t size, std::size_t i, Valuation&& val, SDD<C>&& succ)
+  noexcept
+  {
+    static_assert( alignof(Valuation) <= alignof(SDD<C>)
+                 , "Valuations stored behind successors would be misaligned");
+    new (successors(addr) + i) SDD<C>(std::move(succ));
+    new (valuations(addr, size) + i) Valuation(std::move(val));
+  }
+
+  static
+  void
+  destroy(char* addr, std::size_t size)
+  noexcept
+  {
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      successors(addr)[i].~SDD<C>();
+      valuations(addr, size)[i].~Valuation();
+    }
+  }
+
+  static
+  const_iterator
+  begin(const char* addr, std::size_t size)
+  noexcept
+  {
+    return {successors(addr), valuations(addr, size)};
+  }
+
+  static
+  const_iterator
+  end(const char* addr, std::size_t size)
+  noexcept
+  {
+    return {successors(addr) + size, valuations(addr, size) + size};
+  }
+
+private:
+
+  static
+  SDD<C>*
+  successors(const char* addr)
+  noexcept
+  {
+    return reinterpret_cast<SDD<C>*>(const_cast<char*>(addr));
+  }
+
+  static
+  Valuation*
+  valuations(const char* addr, std::size_t size)
+  noexcept
+  {
+    return reinterpret_cast<Valuation*>(const_cast<char*>(addr) + size * sizeof(SDD<C>));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The layout of alphas selected by the configuration.
+template <typename C, typename Valuation>
+using alpha_layout = std::conditional_t< C::split_alpha
+                                       , split_layout<C, Valuation>
+                                       , interleaved_layout<C, Valuation>>;
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 /// @brief Helper class to build an alpha.
 ///
@@ -136,12 +531,42 @@ public:
     map_.emplace(std::forward<SDD_>(succ), std::forward<Valuation_>(val));
   }
 
+  /// @brief Compute the hash value of the node which would be built from this builder.
+  ///
+  /// It's the same as std::hash<node<C, Valuation>>, thus a node can be looked for in the unique
+  /// table without being constructed.
+  std::size_t
+  hash(typename C::variable_type var)
+  const
+  {
+    std::size_t res = std::hash<typename C::variable_type>()(var);
+    for (const auto& a : map_)
+    {
+      sdd::hash::combine_value(res, arc<C, Valuation>::hash(a.second, a.first));
+    }
+    return res;
+  }
+
+  /// @brief Tell if a node has the variable and the arcs of the node built from this builder.
+  template <typename Node>
+  bool
+  equal(typename C::variable_type var, const Node& n)
+  const noexcept
+  {
+    return n.variable() == var and n.size() == map_.size()
+       and std::equal( map_.begin(), map_.end(), n.begin()
+                     , [](const auto& lhs, const auto& rhs)
+                         {
+                           return rhs.equal(lhs.second, lhs.first);
+                         });
+  }
+
   /// @brief Compute the size needed to store all the arcs contained by this builder.
   std::size_t
   size_to_allocate()
   const noexcept
   {
-    return map_.size() * sizeof(arc<C, Valuation>);
+    return alpha_layout<C, Valuation>::size_to_allocate(map_.size());
   }
 
   /// @brief Move arcs of this builder to a given memory location.
@@ -153,10 +578,11 @@ public:
   consolidate(char* addr)
   noexcept
   {
-    arc<C, Valuation>* base = reinterpret_cast<arc<C, Valuation>*>(addr);
+    std::size_t i = 0;
     for (auto& a : map_)
     {
-      new (base++) arc<C, Valuation>(std::move(a.second), std::move(a.first));
+      alpha_layout<C, Valuation>::construct( addr, map_.size(), i++, std::move(a.second)
+                                           , std::move(a.first));
     }
   }
 };
@@ -177,8 +603,21 @@ struct hash<sdd::arc<C, Valuation>>
   operator()(const sdd::arc<C, Valuation>& arc)
   const
   {
-    using namespace sdd::hash;
-    return seed(arc.valuation()) (val(arc.successor()));
+    return sdd::arc<C, Valuation>::hash(arc.valuation(), arc.successor());
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Hash specialization for sdd::arc_reference
+template <typename C, typename Valuation>
+struct hash<sdd::arc_reference<C, Valuation>>
+{
+  std::size_t
+  operator()(const sdd::arc_reference<C, Valuation>& arc)
+  const
+  {
+    return sdd::arc<C, Valuation>::hash(arc.valuation(), arc.successor());
   }
 };
 
@@ -6,45 +6,90 @@
 
 #pragma once
 
-#include <memory> // make_shared, shared_ptr
+#include <memory>  // make_shared, shared_ptr
+#include <utility> // forward
+#include <vector>
 
 #include "sdd/dd/context_fwd.hh"
 #include "sdd/dd/definition_fwd.hh"
 #include "sdd/dd/difference.hh"
+#include "sdd/dd/difference_sum.hh"
 #include "sdd/dd/intersection.hh"
 #include "sdd/dd/sum.hh"
 #include "sdd/mem/cache.hh"
 #include "sdd/mem/linear_alloc.hh"
+#include "sdd/util/task_pool.hh"
 
 namespace sdd { namespace dd {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief What is shared by all contexts to evaluate operations in parallel.
+struct parallel_evaluation
+{
+  /// @brief The threads which evaluate independent computations.
+  util::task_pool pool;
+
+  /// @brief One memory buffer per worker of the pool.
+  ///
+  /// The first one is the buffer of the context which created the pool.
+  std::vector<std::shared_ptr<mem::arena>> arenas;
+
+  /// @brief The minimal number of independent computations to evaluate them in parallel.
+  const std::size_t threshold;
+
+  parallel_evaluation( std::size_t nb_threads, std::size_t threshold_
+                     , const std::shared_ptr<mem::arena>& arena, std::size_t arena_size)
+    : pool(nb_threads), arenas(), threshold(threshold_)
+  {
+    arenas.reserve(pool.size());
+    arenas.push_back(arena);
+    for (std::size_t i = 1; i < pool.size(); ++i)
+    {
+      arenas.push_back(std::make_shared<mem::arena>(arena_size));
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 /// @brief The evaluation context of operations on SDD (union, intersection, difference).
 ///
 /// Its purpose is to be able to create local caches at different points of the evaluation.
 /// There is a cache per operation type, each of them being wrapped in a std::shared_ptr
 /// to enable cheap copy if we want to transmit caches from context to context.
+///
+/// When created with more than one thread, independent computations can be evaluated in
+/// parallel with parallel_for(). Each thread then gets its own copy of the context, which shares
+/// the caches, but has its own memory buffer.
 template <typename C>
 class context
 {
 public:
 
   /// @brief Cache parameterized by the difference operation.
-  using difference_cache_type = mem::cache<context, difference_op<C>>;
+  using difference_cache_type = typename C::template cache_type<context, difference_op<C>>;
+
+  /// @brief Cache parameterized by the fused (lhs - rhs) + addend operation.
+  using difference_sum_cache_type
+    = typename C::template cache_type<context, difference_sum_op<C>>;
 
   /// @brief Cache parameterized by the intersection operation.
-  using intersection_cache_type = mem::cache<context, intersection_op<C>>;
+  using intersection_cache_type = typename C::template cache_type<context, intersection_op<C>>;
 
   /// @brief Cache parameterized by the sum operation.
-  using sum_cache_type = mem::cache<context, sum_op<C>>;
+  using sum_cache_type = typename C::template cache_type<context, sum_op<C>>;
 
 private:
 
   /// @brief Cache of SDD difference.
   std::shared_ptr<difference_cache_type> difference_cache_;
 
+  /// @brief Cache of SDD fused (lhs - rhs) + addend.
+  std::shared_ptr<difference_sum_cache_type> difference_sum_cache_;
+
   /// @brief Cache of SDD intersection.
   std::shared_ptr<intersection_cache_type> intersection_cache_;
 
@@ -54,20 +99,89 @@ private:
   /// @brief Buffer for temporary containers allocation.
   std::shared_ptr<mem::arena> arena_;
 
+  /// @brief The parallel evaluation engine, nullptr when operations are evaluated sequentially.
+  std::shared_ptr<parallel_evaluation> parallel_;
+
 public:
 
   /// @brief Create a new empty context.
-  context( std::size_t difference_size, std::size_t intersection_size, std::size_t sum_size
-         , std::size_t arena_size)
+  /// @param nb_threads The number of threads to evaluate operations; 1 for a sequential
+  /// evaluation.
+  /// @param parallel_threshold The minimal number of independent computations to evaluate them
+  /// in parallel.
+  context( std::size_t difference_size, std::size_t difference_sum_size
+         , std::size_t intersection_size, std::size_t sum_size, std::size_t arena_size
+         , std::size_t nb_threads = 1, std::size_t parallel_threshold = 0)
     : difference_cache_{std::make_shared<difference_cache_type>(*this, difference_size)}
+    , difference_sum_cache_{std::make_shared<difference_sum_cache_type>( *this
+                                                                       , difference_sum_size)}
     , intersection_cache_{std::make_shared<intersection_cache_type>( *this, intersection_size)}
     , sum_cache_{std::make_shared<sum_cache_type>(*this, sum_size)}
     , arena_{std::make_shared<mem::arena>(arena_size)}
+    , parallel_{ nb_threads > 1
+               ? std::make_shared<parallel_evaluation>( nb_threads, parallel_threshold, arena_
+                                                      , arena_size)
+               : nullptr}
   {}
 
   /// @brief Copy constructor.
   context(const context&) = default;
 
+  /// @brief Construct the context of a worker of the parallel evaluation engine.
+  ///
+  /// It shares the caches of other, but uses the memory buffer of the worker.
+  context(const context& other, std::size_t worker)
+    : difference_cache_{other.difference_cache_}
+    , difference_sum_cache_{other.difference_sum_cache_}
+    , intersection_cache_{other.intersection_cache_}
+    , sum_cache_{other.sum_cache_}
+    , arena_{other.parallel_->arenas[worker]}
+    , parallel_{other.parallel_}
+  {}
+
+  /// @brief Evaluate f(cxt, i) for each i in [0, nb_tasks), where cxt is the context to use.
+  ///
+  /// Computations are evaluated in parallel if there are enough of them and if this context has
+  /// been created with more than one thread. Each computation must be independent of the others.
+  template <typename Function>
+  void
+  parallel_for(std::size_t nb_tasks, Function&& f)
+  {
+    parallel_for(nb_tasks, parallel_ ? parallel_->threshold : 0, std::forward<Function>(f));
+  }
+
+  /// @brief Evaluate f(cxt, i) for each i in [0, nb_tasks), with a specific threshold.
+  ///
+  /// Used by callers whose computations are known to be coarse-grained.
+  template <typename Function>
+  void
+  parallel_for(std::size_t nb_tasks, std::size_t threshold, Function&& f)
+  {
+    if (parallel_ and nb_tasks > 1 and nb_tasks >= threshold)
+    {
+      parallel_->pool.parallel_for(nb_tasks, [&](std::size_t worker, std::size_t i)
+      {
+        context worker_cxt(*this, worker);
+        f(worker_cxt, i);
+      });
+    }
+    else
+    {
+      for (std::size_t i = 0; i < nb_tasks; ++i)
+      {
+        f(*this, i);
+      }
+    }
+  }
+
+  /// @brief Tell if this context can evaluate computations in parallel.
+  bool
+  parallel()
+  const noexcept
+  {
+    return parallel_ != nullptr;
+  }
+
   /// @brief Get the difference cache.
   difference_cache_type&
   difference_cache()
@@ -76,6 +190,14 @@ public:
     return *difference_cache_;
   }
 
+  /// @brief Get the fused (lhs - rhs) + addend cache.
+  difference_sum_cache_type&
+  difference_sum_cache()
+  noexcept
+  {
+    return *difference_sum_cache_;
+  }
+
   /// @brief Get the intersection cache.
   intersection_cache_type&
   intersection_cache()
@@ -106,6 +228,7 @@ public:
   noexcept
   {
     difference_cache_->clear();
+    difference_sum_cache_->clear();
     intersection_cache_->clear();
     sum_cache_->clear();
   }
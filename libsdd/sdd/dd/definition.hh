@@ -19,6 +19,7 @@
 #include "sdd/dd/terminal.hh"
 #include "sdd/dd/top.hh"
 #include "sdd/mem/ptr.hh"
+#include "sdd/mem/sharded_unique_table.hh"
 #include "sdd/mem/unique.hh"
 #include "sdd/mem/variant.hh"
 #include "sdd/order/order.hh"
@@ -59,14 +60,15 @@ public:
   /// @brief A unified and canonized SDD, meant to be stored in a unique table.
   ///
   /// It is automatically erased when there is no more reference to it.
-  using unique_type = mem::unique<data_type>;
+  using unique_type = mem::unique<data_type, typename C::reference_counter_type>;
 
   /// @internal
   /// @brief The type of the smart pointer around a unified SDD.
   ///
   /// It handles the reference counting as well as the deletion of the SDD when it is no longer
   /// referenced.
-  using ptr_type = mem::ptr<unique_type>;
+  using ptr_type =
+    mem::ptr<unique_type, mem::table_deleter<typename C::template unique_table_type<unique_type>>>;
 
   /// @brief The type of variables.
   using variable_type = typename C::variable_type;
@@ -422,7 +424,7 @@ private:
     {
       dd::alpha_builder<C, Valuation> builder(cxt);
       builder.add(std::move(val), succ);
-      return ptr_type(&unify_node<Valuation>(var, std::move(builder)));
+      return unify_node<Valuation>(var, std::move(builder));
     }
   }
 
@@ -443,7 +445,7 @@ private:
     {
       dd::alpha_builder<C, Valuation> builder(cxt);
       builder.add(val, succ);
-      return ptr_type(&unify_node<Valuation>(var, std::move(builder)));
+      return unify_node<Valuation>(var, std::move(builder));
     }
   }
 
@@ -462,7 +464,7 @@ private:
     }
     else
     {
-      return ptr_type(&unify_node<Valuation>(var, std::move(builder)));
+      return unify_node<Valuation>(var, std::move(builder));
     }
   }
 
@@ -472,18 +474,28 @@ private:
   /// O(n) where n is the number of arcs in the builder.
   template <typename Valuation>
   static
-  unique_type&
+  ptr_type
   unify_node(variable_type var, dd::alpha_builder<C, Valuation>&& builder)
   {
-    // Will be erased by the unicity table, either it's an already existing node or a deletion
-    // is requested by ptr.
-    // Note that the alpha function is allocated right behind the node, thus extra care must be
-    // taken.
+    // The node is looked for with the arcs of the builder, it's constructed only if it doesn't
+    // exist yet. Note that the alpha function is allocated right behind the node, thus extra care
+    // must be taken.
+    using node_type = node<C, Valuation>;
     auto& ut = global<C>().sdd_unique_table;
-    char* addr = ut.allocate(builder.size_to_allocate());
-    unique_type* u =
-      new (addr) unique_type(mem::construct<node<C, Valuation>>(), var, builder);
-    return ut(u, builder.size_to_allocate());
+    const auto hash = data_type::template hash_of<node_type>(builder.hash(var));
+    return mem::make_ptr( ut, hash
+                        , [&](const data_type& x)
+                            {
+                              return mem::is<node_type>(x)
+                                 and builder.equal(var, mem::variant_cast<node_type>(x));
+                            }
+                        , builder.size_to_allocate()
+                        , [&](char* addr)
+                            {
+                              return new (addr) unique_type( mem::precomputed_hash, hash
+                                                           , mem::construct<node_type>(), var
+                                                           , builder);
+                            });
   }
 };
 
@@ -6,8 +6,15 @@
 
 #pragma once
 
+#include <algorithm> // lower_bound, sort
 #include <cassert>
 #include <iosfwd>
+#include <tuple>
+#include <type_traits> // enable_if, is_same
+#include <utility> // pair
+#include <vector>
+
+#include <boost/container/flat_map.hpp>
 
 #include "sdd/internal_manager_fwd.hh"
 #include "sdd/dd/context_fwd.hh"
@@ -15,8 +22,10 @@
 #include "sdd/dd/operations_fwd.hh"
 #include "sdd/dd/square_union.hh"
 #include "sdd/dd/top.hh"
+#include "sdd/mem/linear_alloc.hh"
 #include "sdd/util/hash.hh"
 #include "sdd/values/empty.hh"
+#include "sdd/values/values_traits.hh"
 
 namespace sdd {
 
@@ -49,23 +58,64 @@ struct difference_visitor
 
     mem::rewinder _(cxt_.arena());
 
+    square_union<C, Valuation> su(cxt_);
+
+    // Each arc of lhs is possibly added two times, modified: first for its part which is not in
+    // rhs, then for all common parts.
+    su.reserve(lhs.size() * 2);
+
+    // The common parts of arcs, whose successors have to be substracted.
+    using arc_iterator = typename node<C, Valuation>::const_iterator;
+    using job_type = std::tuple<Valuation, arc_iterator, arc_iterator>;
+    std::vector<job_type, mem::linear_alloc<job_type>>
+      jobs(mem::linear_alloc<job_type>(cxt_.arena()));
+
+    split(lhs, rhs, su, jobs);
+
+    // Propagate the difference on succcessors. As these differences are independent, they can be
+    // evaluated in parallel.
+    std::vector<SDD<C>, mem::linear_alloc<SDD<C>>>
+      succs(jobs.size(), mem::linear_alloc<SDD<C>>(cxt_.arena()));
+    cxt_.parallel_for(jobs.size(), [&](context<C>& local_cxt, std::size_t i)
+    {
+      const auto& job = jobs[i];
+      succs[i] = difference( local_cxt, std::get<1>(job)->successor()
+                           , std::get<2>(job)->successor());
+    });
+
+    for (std::size_t i = 0; i < jobs.size(); ++i)
+    {
+      if (not values::empty_values(succs[i]))
+      {
+        su.add(std::move(succs[i]), std::move(std::get<0>(jobs[i])));
+      }
+    }
+
+    return su.empty()
+         ? zero<C>() // avoid a useless allocation when calling square_union::operator()
+         : SDD<C>(lhs.variable(), su());
+  }
+
+  /// @brief Split the arcs of lhs into parts not in rhs and parts common with an arc of rhs.
+  ///
+  /// Parts not in rhs are added to the square union, common parts are added to jobs.
+  template <typename Valuation, typename SquareUnion, typename Jobs>
+  std::enable_if_t< not std::is_same<Valuation, typename C::Values>::value
+                    or not values::values_traits<typename C::Values>::fast_iterable>
+  split(const node<C, Valuation>& lhs, const node<C, Valuation>& rhs, SquareUnion& su, Jobs& jobs)
+  const
+  {
     // Compute union of all rhs valuations.
     sum_builder<C, Valuation> sum_builder(cxt_);
     sum_builder.reserve(rhs.size());
-    for (auto& rhs_arc : rhs)
+    for (const auto& rhs_arc : rhs)
     {
       sum_builder.add(rhs_arc.valuation());
     }
     auto rhs_union = sum(cxt_, std::move(sum_builder));
 
-    square_union<C, Valuation> su(cxt_);
-
-    // We iterate two times on lhs's alpha, and we possibly add each arc, modified, two times.
-    // First when removing rhs_union, then when we look for all common parts.
-    su.reserve(lhs.size() * 2);
-
     // For each valuation of lhs, remove the quantity rhs_union.
-    for (auto& lhs_arc : lhs)
+    for (const auto& lhs_arc : lhs)
     {
       auto tmp = difference(cxt_, lhs_arc.valuation(), rhs_union);
       if (not values::empty_values(tmp))
@@ -74,29 +124,90 @@ struct difference_visitor
       }
     }
 
-    // For all common parts, propagate the difference on succcessors.
-    for (auto& lhs_arc : lhs)
+    // Look for all common parts.
+    for (auto lhs_arc = lhs.begin(); lhs_arc != lhs.end(); ++lhs_arc)
     {
-      for (auto& rhs_arc : rhs)
+      for (auto rhs_arc = rhs.begin(); rhs_arc != rhs.end(); ++rhs_arc)
       {
         intersection_builder<C, Valuation> inter_builder(cxt_);
-        inter_builder.add(lhs_arc.valuation());
-        inter_builder.add(rhs_arc.valuation());
+        inter_builder.add(lhs_arc->valuation());
+        inter_builder.add(rhs_arc->valuation());
         Valuation tmp_val = intersection(cxt_, std::move(inter_builder));
         if (not values::empty_values(tmp_val))
         {
-          SDD<C> tmp_succ = difference(cxt_, lhs_arc.successor(), rhs_arc.successor());
-          if (not values::empty_values(tmp_succ))
-          {
-            su.add(std::move(tmp_succ), std::move(tmp_val));
-          }
+          jobs.emplace_back(std::move(tmp_val), lhs_arc, rhs_arc);
         }
       }
     }
+  }
 
-    return su.empty()
-         ? zero<C>() // avoid a useless allocation when calling square_union::operator()
-         : SDD<C>(lhs.variable(), su());
+  /// @brief Split the arcs of lhs, for flat nodes whose valuations are "fast iterable".
+  ///
+  /// Each value of rhs is mapped to its arc, thus only the common parts are visited.
+  template <typename Valuation, typename SquareUnion, typename Jobs>
+  std::enable_if_t< std::is_same<Valuation, typename C::Values>::value
+                    and values::values_traits<typename C::Values>::fast_iterable>
+  split(const node<C, Valuation>& lhs, const node<C, Valuation>& rhs, SquareUnion& su, Jobs& jobs)
+  const
+  {
+    using values_type    = typename C::Values;
+    using values_builder = typename values::values_traits<values_type>::builder;
+    using value_type     = typename values_type::value_type;
+    using arc_iterator   = typename node<C, Valuation>::const_iterator;
+
+    // The arc of rhs of each value, sorted by values. Valuations of an alpha being disjoint, a
+    // value appears only once.
+    using index_type = std::pair<value_type, arc_iterator>;
+    std::vector<index_type, mem::linear_alloc<index_type>>
+      value_to_arc(mem::linear_alloc<index_type>(cxt_.arena()));
+    for (auto rhs_arc = rhs.begin(); rhs_arc != rhs.end(); ++rhs_arc)
+    {
+      for (const auto& value : rhs_arc->valuation())
+      {
+        value_to_arc.emplace_back(value, rhs_arc);
+      }
+    }
+    const auto index_less = [](const index_type& lhs_idx, const index_type& rhs_idx)
+                              {return lhs_idx.first < rhs_idx.first;};
+    std::sort(value_to_arc.begin(), value_to_arc.end(), index_less);
+
+    using common_type = std::pair<arc_iterator, values_builder>;
+    boost::container::flat_map< arc_iterator, values_builder, std::less<arc_iterator>
+                              , mem::linear_alloc<common_type>>
+      common(std::less<arc_iterator>(), mem::linear_alloc<common_type>(cxt_.arena()));
+
+    for (auto lhs_arc = lhs.begin(); lhs_arc != lhs.end(); ++lhs_arc)
+    {
+      // The values of lhs_arc not in rhs.
+      values_builder remainder;
+
+      // Values of an arc are sorted, thus the search can start from the previous position.
+      auto search = value_to_arc.cbegin();
+      for (const auto& value : lhs_arc->valuation())
+      {
+        search = std::lower_bound( search, value_to_arc.cend(), index_type(value, rhs.end())
+                                 , index_less);
+        if (search == value_to_arc.cend() or value < search->first)
+        {
+          remainder.insert(value);
+        }
+        else
+        {
+          auto& common_values = common[search->second];
+          common_values.insert(value);
+        }
+      }
+
+      if (not remainder.empty())
+      {
+        su.add(lhs_arc->successor(), values_type(std::move(remainder)));
+      }
+      for (auto& arc_values : common)
+      {
+        jobs.emplace_back(values_type(std::move(arc_values.second)), lhs_arc, arc_values.first);
+      }
+      common.clear();
+    }
   }
 
   /// @brief Always an error, difference with |0| is not cached.
@@ -189,7 +300,7 @@ difference(context<C>& cxt, SDD<C> lhs, SDD<C> rhs)
   {
     return lhs;
   }
-  return cxt.difference_cache()({std::move(lhs), std::move(rhs)});
+  return cxt.difference_cache()(cxt, {std::move(lhs), std::move(rhs)});
 }
 
 /*------------------------------------------------------------------------------------------------*/
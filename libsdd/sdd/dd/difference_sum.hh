@@ -0,0 +1,275 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <iosfwd>
+#include <type_traits> // enable_if, is_same
+#include <vector>
+
+#include <boost/container/flat_map.hpp>
+
+#include "sdd/internal_manager_fwd.hh"
+#include "sdd/dd/check_compatibility.hh"
+#include "sdd/dd/context_fwd.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/dd/operations_fwd.hh"
+#include "sdd/mem/linear_alloc.hh"
+#include "sdd/util/hash.hh"
+#include "sdd/values/empty.hh"
+#include "sdd/values/values_traits.hh"
+
+namespace sdd { namespace dd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The successors of a value in each operand of a difference_sum operation.
+template <typename C>
+struct difference_sum_successors
+{
+  SDD<C> lhs = zero<C>();
+  SDD<C> rhs = zero<C>();
+  SDD<C> addend = zero<C>();
+};
+
+/// @internal
+/// @brief Implementation of the fused (lhs - rhs) + addend operation.
+template <typename C>
+struct difference_sum_impl
+{
+  /// @brief Operands are flat nodes whose valuations are "fast iterable".
+  ///
+  /// Values are mapped to their successors in each operand, thus the result is computed in a
+  /// single traversal, without building the intermediary difference.
+  template <typename Values = typename C::Values>
+  static
+  std::enable_if_t<values::values_traits<Values>::fast_iterable, SDD<C>>
+  work(context<C>& cxt, const SDD<C>& lhs, const SDD<C>& rhs, const SDD<C>& addend)
+  {
+    if (not (mem::is<flat_node<C>>(*lhs) and mem::is<flat_node<C>>(*rhs)
+             and mem::is<flat_node<C>>(*addend)))
+    {
+      return fallback(cxt, lhs, rhs, addend);
+    }
+
+    // Throw a Top if operands are incompatible (different variables).
+    check_compatibility(lhs, rhs);
+    check_compatibility(lhs, addend);
+
+    mem::rewinder _(cxt.arena());
+
+    using values_builder   = typename values::values_traits<Values>::builder;
+    using value_type       = typename Values::value_type;
+    using successors_type  = difference_sum_successors<C>;
+    using map_value_type   = std::pair<value_type, successors_type>;
+    boost::container::flat_map< value_type, successors_type, std::less<value_type>
+                              , mem::linear_alloc<map_value_type>>
+      value_to_succs( std::less<value_type>()
+                    , mem::linear_alloc<map_value_type>(cxt.arena()));
+
+    // The values of rhs not in lhs are useless.
+    for (const auto& arc : mem::variant_cast<flat_node<C>>(*lhs))
+    {
+      for (const auto& value : arc.valuation())
+      {
+        value_to_succs.emplace_hint(value_to_succs.end(), value, successors_type())
+          ->second.lhs = arc.successor();
+      }
+    }
+    for (const auto& arc : mem::variant_cast<flat_node<C>>(*rhs))
+    {
+      for (const auto& value : arc.valuation())
+      {
+        const auto search = value_to_succs.find(value);
+        if (search != value_to_succs.end())
+        {
+          search->second.rhs = arc.successor();
+        }
+      }
+    }
+    for (const auto& arc : mem::variant_cast<flat_node<C>>(*addend))
+    {
+      for (const auto& value : arc.valuation())
+      {
+        value_to_succs[value].addend = arc.successor();
+      }
+    }
+
+    // The successors are independent, they can be evaluated in parallel.
+    std::vector<SDD<C>, mem::linear_alloc<SDD<C>>>
+      succs(value_to_succs.size(), mem::linear_alloc<SDD<C>>(cxt.arena()));
+    cxt.parallel_for(value_to_succs.size(), [&](context<C>& local_cxt, std::size_t i)
+    {
+      const auto& value_succs = (value_to_succs.begin() + i)->second;
+      succs[i] = difference_sum(local_cxt, value_succs.lhs, value_succs.rhs, value_succs.addend);
+    });
+
+    // Like in the linear union, values with the same successor are gathered with a values_builder.
+    boost::container::flat_map< SDD<C>, values_builder, std::less<SDD<C>>
+                              , mem::linear_alloc<std::pair<SDD<C>, values_builder>>>
+      succ_to_value( std::less<SDD<C>>()
+                   , mem::linear_alloc<std::pair<SDD<C>, values_builder>>(cxt.arena()));
+    succ_to_value.reserve(value_to_succs.size());
+
+    auto succ_cit = succs.begin();
+    for (const auto& value_succs : value_to_succs)
+    {
+      SDD<C>& succ = *succ_cit++;
+      if (values::empty_values(succ))
+      {
+        continue;
+      }
+      auto& builder = succ_to_value[std::move(succ)];
+      builder.insert(value_succs.first);
+    }
+
+    if (succ_to_value.empty())
+    {
+      return zero<C>();
+    }
+
+    alpha_builder<C, Values> alpha(cxt);
+    alpha.reserve(succ_to_value.size());
+    for (auto& succ_values : succ_to_value)
+    {
+      alpha.add(Values(std::move(succ_values.second)), std::move(succ_values.first));
+    }
+
+    return SDD<C>(mem::variant_cast<flat_node<C>>(*lhs).variable(), std::move(alpha));
+  }
+
+  /// @brief Valuations are not "fast iterable".
+  template <typename Values = typename C::Values>
+  static
+  std::enable_if_t<not values::values_traits<Values>::fast_iterable, SDD<C>>
+  work(context<C>& cxt, const SDD<C>& lhs, const SDD<C>& rhs, const SDD<C>& addend)
+  {
+    return fallback(cxt, lhs, rhs, addend);
+  }
+
+  /// @brief Compute the difference, then the union.
+  static
+  SDD<C>
+  fallback(context<C>& cxt, const SDD<C>& lhs, const SDD<C>& rhs, const SDD<C>& addend)
+  {
+    return sum(cxt, {cxt, {difference(cxt, lhs, rhs), addend}});
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The fused (lhs - rhs) + addend operation in the cache.
+template <typename C>
+struct difference_sum_op
+{
+  /// @brief The left operand of the difference.
+  const SDD<C> lhs;
+
+  /// @brief The right operand of the difference.
+  const SDD<C> rhs;
+
+  /// @brief The operand added to the difference.
+  const SDD<C> addend;
+
+  /// @brief Apply this operation.
+  ///
+  /// Called by the cache.
+  SDD<C>
+  operator()(context<C>& cxt)
+  const
+  {
+    return difference_sum_impl<C>::work(cxt, lhs, rhs, addend);
+  }
+
+  friend
+  bool
+  operator==(const difference_sum_op& lhs, const difference_sum_op& rhs)
+  noexcept
+  {
+    return lhs.lhs == rhs.lhs and lhs.rhs == rhs.rhs and lhs.addend == rhs.addend;
+  }
+
+  friend
+  std::ostream&
+  operator<<(std::ostream& os, const difference_sum_op& x)
+  {
+    return os << "-+ (" << x.lhs << "," << x.rhs << "," << x.addend << ")";
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @related SDD
+/// @brief The fused (lhs - rhs) + addend operation.
+///
+/// The computation is cached, except for the trivial cases (when an operand is |0| or when two
+/// operands are equal), which are reduced to a single operation.
+template <typename C>
+inline
+SDD<C>
+difference_sum(context<C>& cxt, const SDD<C>& lhs, const SDD<C>& rhs, const SDD<C>& addend)
+{
+  if (lhs == rhs or lhs == zero<C>())
+  {
+    return addend;
+  }
+  else if (addend == zero<C>())
+  {
+    return difference(cxt, lhs, rhs);
+  }
+  else if (rhs == zero<C>() or rhs == addend)
+  {
+    return sum(cxt, {cxt, {lhs, addend}});
+  }
+  else if (lhs == addend)
+  {
+    return lhs;
+  }
+  return cxt.difference_sum_cache()(cxt, {lhs, rhs, addend});
+}
+
+} // namespace dd
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Perform (lhs - rhs) + addend without building the intermediary difference.
+/// @related SDD
+template <typename C>
+inline
+SDD<C>
+difference_sum(const SDD<C>& lhs, const SDD<C>& rhs, const SDD<C>& addend)
+{
+  return dd::difference_sum(global<C>().sdd_context, lhs, rhs, addend);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
+
+namespace std {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Hash specialization for sdd::dd::difference_sum_op
+template <typename C>
+struct hash<sdd::dd::difference_sum_op<C>>
+{
+  std::size_t
+  operator()(const sdd::dd::difference_sum_op<C>& op)
+  const
+  {
+    using namespace sdd::hash;
+    return seed(op.lhs) (val(op.rhs)) (val(op.addend));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace std
@@ -6,6 +6,10 @@
 
 #pragma once
 
+#include <algorithm> // max
+#include <iterator> // distance, next
+#include <vector>
+
 #include <boost/container/flat_set.hpp>
 
 #include "sdd/internal_manager_fwd.hh"
@@ -32,6 +36,9 @@ struct LIBSDD_ATTRIBUTE_PACKED intersection_op_impl
   static constexpr char symbol = '&';
 
   /// @brief Perform the SDD intersection algorithm.
+  ///
+  /// The alphas of all operands are intersected at once: only the final node is unified. Each
+  /// part of the resulting alpha is a chain of arcs, one per operand, whose valuations overlap.
   template <typename InputIterator, typename NodeType>
   static
   SDD<C>
@@ -40,65 +47,103 @@ struct LIBSDD_ATTRIBUTE_PACKED intersection_op_impl
     using node_type      = NodeType;
     using valuation_type = typename node_type::valuation_type;
     using variable_type  = typename node_type::variable_type;
+    using arc_iterator   = typename node_type::const_iterator;
 
     mem::rewinder _(cxt.arena());
 
-    auto operands_cit = begin;
-    const auto operands_end = end;
-
-    // Result accumulator, initialized with the first operand.
-    SDD<C> res = *operands_cit;
-
-    const variable_type variable = mem::variant_cast<node_type>(**operands_cit).variable();
+    const variable_type variable = mem::variant_cast<node_type>(**begin).variable();
 
-    // We re-use the same square union to save some allocations.
-    square_union<C, valuation_type> su(cxt);
+    // A common part of the arcs of the operands visited so far. Its arc for the current operand is
+    // arc, the arcs for the previous operands are found by following the parent indices.
+    struct part
+    {
+      valuation_type valuation;
+      std::size_t parent;
+      arc_iterator arc;
+    };
+    using parts_type = std::vector<part, mem::linear_alloc<part>>;
+
+    // The parts for each operand.
+    std::vector<parts_type, mem::linear_alloc<parts_type>>
+      parts(mem::linear_alloc<parts_type>(cxt.arena()));
+    parts.reserve(std::distance(begin, end));
+
+    // Initialize the parts with the alpha of the first operand.
+    const node_type& head = mem::variant_cast<node_type>(**begin);
+    parts.emplace_back(mem::linear_alloc<part>(cxt.arena()));
+    parts.back().reserve(head.size());
+    for (auto arc = head.begin(); arc != head.end(); ++arc)
+    {
+      parts.back().push_back(part{arc->valuation(), 0, arc});
+    }
 
-    for (++operands_cit; operands_cit != operands_end; ++operands_cit)
+    for (auto operands_cit = std::next(begin); operands_cit != end; ++operands_cit)
     {
       // Throw a Top if operands are incompatible (different types or different variables).
-      check_compatibility(res, *operands_cit);
-
-      // Cleanup for the next usage.
-      su.clear();
+      check_compatibility(*begin, *operands_cit);
 
-      const node_type& lhs = mem::variant_cast<node_type>(*res);
-      const node_type& rhs = mem::variant_cast<node_type>(**operands_cit);
+      const node_type& node = mem::variant_cast<node_type>(**operands_cit);
+      parts.emplace_back(mem::linear_alloc<part>(cxt.arena()));
+      const auto& previous = parts[parts.size() - 2];
+      auto& current = parts.back();
+      current.reserve(std::max(previous.size(), static_cast<std::size_t>(node.size())));
 
-      for (auto& lhs_arc : lhs)
+      for (std::size_t i = 0; i < previous.size(); ++i)
       {
-        for (auto& rhs_arc : rhs)
+        for (auto arc = node.begin(); arc != node.end(); ++arc)
         {
           intersection_builder<C, valuation_type> valuation_builder(cxt);
-          valuation_builder.add(lhs_arc.valuation());
-          valuation_builder.add(rhs_arc.valuation());
+          valuation_builder.add(previous[i].valuation);
+          valuation_builder.add(arc->valuation());
           valuation_type inter_val = intersection(cxt, std::move(valuation_builder));
 
           if (not values::empty_values(inter_val))
           {
-            SDD<C> inter_succ
-              = intersection(cxt, intersection_builder<C, SDD<C>>(cxt, { lhs_arc.successor()
-                                                                       , rhs_arc.successor()}));
-
-            if (not values::empty_values(inter_succ))
-            {
-              su.add(std::move(inter_succ), std::move(inter_val));
-            }
+            current.push_back(part{std::move(inter_val), i, arc});
           }
         }
       }
 
-      // Exit as soon as an intermediary result is empty.
-      if (su.empty())
+      // Exit as soon as there are no more common parts.
+      if (current.empty())
       {
         return zero<C>();
       }
+    }
 
-      /// @todo avoid to create an intermediary SDD at each loop.
-      res = SDD<C>(variable, su());
+    // Successors are intersected only for complete chains. As these intersections are
+    // independent, they can be evaluated in parallel.
+    const auto& last = parts.back();
+    std::vector<SDD<C>, mem::linear_alloc<SDD<C>>>
+      succs(last.size(), mem::linear_alloc<SDD<C>>(cxt.arena()));
+    cxt.parallel_for(last.size(), [&](context<C>& local_cxt, std::size_t i)
+    {
+      intersection_builder<C, SDD<C>> succ_builder(local_cxt);
+      succ_builder.reserve(parts.size());
+      for (auto level = parts.size(), j = i; level > 0; --level)
+      {
+        const auto& p = parts[level - 1][j];
+        succ_builder.add(p.arc->successor());
+        j = p.parent;
+      }
+      succs[i] = intersection(local_cxt, std::move(succ_builder));
+    });
+
+    square_union<C, valuation_type> su(cxt);
+    su.reserve(last.size());
+    for (std::size_t i = 0; i < last.size(); ++i)
+    {
+      if (not values::empty_values(succs[i]))
+      {
+        su.add(std::move(succs[i]), last[i].valuation);
+      }
     }
 
-    return res;
+    if (su.empty())
+    {
+      return zero<C>();
+    }
+    return SDD<C>(variable, su());
   }
 };
 
@@ -147,7 +192,7 @@ intersection(context<C>& cxt, intersection_builder<C, SDD<C>>&& builder)
   {
     return *builder.begin();
   }
-  return cxt.intersection_cache()({builder});
+  return cxt.intersection_cache()(cxt, {builder});
 }
 
 /*------------------------------------------------------------------------------------------------*/
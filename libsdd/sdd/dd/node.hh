@@ -9,6 +9,7 @@
 #include <algorithm>  // equal, for_each
 #include <functional> // hash
 #include <iosfwd>
+#include <iterator>   // iterator_traits
 
 #include "sdd/dd/alpha.hh"
 #include "sdd/dd/definition.hh"
@@ -48,11 +49,14 @@ public:
   /// @brief The type used to store the number of arcs of this node.
   using alpha_size_type = typename C::alpha_size_type;
 
+  /// @brief How arcs are stored behind this node.
+  using alpha_layout = dd::alpha_layout<C, Valuation>;
+
   /// @brief A (const) iterator on the arcs of this node.
-  using const_iterator = const arc<C, Valuation>*;
+  using const_iterator = typename alpha_layout::const_iterator;
 
   /// @brief The arc type.
-  using arc_type = arc<C, Valuation>;
+  using arc_type = typename std::iterator_traits<const_iterator>::value_type;
 
 private:
 
@@ -83,10 +87,7 @@ public:
   /// O(n) where n is the number of arcs in the node.
   ~node()
   {
-    for (auto& a : *this)
-    {
-      a.~arc<C, Valuation>();
-    }
+    alpha_layout::destroy(alpha_addr(), size_);
   }
 
   /// @brief Get the variable of this node.
@@ -106,7 +107,7 @@ public:
   begin()
   const noexcept
   {
-    return reinterpret_cast<const arc<C, Valuation>*>(alpha_addr());
+    return alpha_layout::begin(alpha_addr(), size_);
   }
 
   /// @brief Get the end of arcs.
@@ -116,7 +117,7 @@ public:
   end()
   const noexcept
   {
-    return reinterpret_cast<const arc<C, Valuation>*>(alpha_addr()) + size_;
+    return alpha_layout::end(alpha_addr(), size_);
   }
 
   /// @brief Get the number of arcs.
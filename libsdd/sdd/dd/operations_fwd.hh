@@ -28,6 +28,13 @@ difference(context<C>&, const Values&, const Values&);
 
 /*------------------------------------------------------------------------------------------------*/
 
+// Forward declaration of the fused (lhs - rhs) + addend operation.
+template <typename C>
+SDD<C>
+difference_sum(context<C>&, const SDD<C>&, const SDD<C>&, const SDD<C>&);
+
+/*------------------------------------------------------------------------------------------------*/
+
 // Forward declaration of the intersection builder policy.
 struct intersection_builder_policy;
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <initializer_list>
+#include <limits> // numeric_limits
 #include <type_traits> // enable_if, is_same
 #include <unordered_map>
 #include <vector>
@@ -41,7 +42,11 @@ struct LIBSDD_ATTRIBUTE_PACKED sum_op_impl
   /// @brief Perform the SDD union algorithm.
   ///
   /// It's a so-called 'n-ary' union in the sense that we don't create intermediary SDD.
-  /// Also, a lot of tests permit to break loops as soon as possible.
+  ///
+  /// The valuations of all operands are refined into a partition. First, arcs with the same
+  /// valuation are grouped, without any operation on valuations. Then, each group is split
+  /// against the blocks of the partition it overlaps. As the valuations of an alpha are
+  /// disjoint, blocks which come from the same operand are never intersected.
   template <typename InputIterator, typename NodeType>
   static
   std::enable_if_t< std::is_same<NodeType, hierarchical_node<C>>::value
@@ -54,164 +59,141 @@ struct LIBSDD_ATTRIBUTE_PACKED sum_op_impl
 
     mem::rewinder _(cxt.arena());
 
-    auto operands_cit = begin;
-    const auto operands_end = end;
-
-    // Get the first operand as a node, we need it to initialize the algorithm.
-    const node_type& head = mem::variant_cast<node_type>(**operands_cit);
+    const node_type& head = mem::variant_cast<node_type>(**begin);
 
     // Type of the list of successors for a valuation, to be merged with the union operation
     // right before calling the square union.
     using sum_builder_type = sum_builder<C, SDD<C>>;
 
-    /// @todo Use intrusive hash map to save on memory allocations?
-    // List all the successors for each valuation in the final alpha.
-    std::unordered_map< valuation_type
-                      , sum_builder_type
-                      , std::hash<valuation_type>
-                      , std::equal_to<valuation_type>
-                      , mem::linear_alloc<std::pair<const valuation_type, sum_builder_type>>
-                      >
-      res( head.size(), std::hash<valuation_type>(), std::equal_to<valuation_type>()
-         , mem::linear_alloc<std::pair<const valuation_type, sum_builder_type>>(cxt.arena()));
-
-    using pair_type = std::pair<valuation_type, sum_builder_type>;
-
-    // Needed to temporarily store arcs erased from res and arcs from the alpha visited in
-    // the loop (B).
-    std::vector<pair_type, mem::linear_alloc<pair_type>>
-      save(mem::linear_alloc<pair_type>(cxt.arena()));
-    save.reserve(head.size());
-
-    // Used in test (F).
-    std::vector<pair_type, mem::linear_alloc<pair_type>>
-      remainder(mem::linear_alloc<pair_type>(cxt.arena()));
-    remainder.reserve(head.size());
-
-    // Initialize res with the alpha of the first operand.
-    for (const auto& arc : head)
-    {
-      sum_builder_type succs(cxt);
-      succs.add(arc.successor());
-      res.emplace(arc.valuation(), std::move(succs));
-    }
+    // Tell that a block is included in arcs of several operands.
+    static constexpr std::size_t several_operands = std::numeric_limits<std::size_t>::max();
 
-    // (A).
-    for (++operands_cit; operands_cit != operands_end; ++operands_cit)
+    // A part of the final alpha.
+    struct block
     {
-      // Throw a Top if operands are incompatible (different types or different variables).
-      check_compatibility(*begin, *operands_cit);
-
-      const auto res_end = res.end();
-
-      const node_type& node = mem::variant_cast<node_type>(**operands_cit);
-      const auto alpha_end = node.end();
-
-      // (B). For each arc of the current operand.
-      for (auto alpha_cit = node.begin(); alpha_cit != alpha_end; ++alpha_cit)
+      valuation_type valuation;
+      sum_builder_type successors;
+      // The operand whose arc contains this block, or several_operands.
+      std::size_t origin;
+    };
+
+    // (A). Group the arcs of all operands by valuation.
+    std::vector<block, mem::linear_alloc<block>> groups(mem::linear_alloc<block>(cxt.arena()));
+    groups.reserve(head.size());
+    {
+      using map_value_type = std::pair<const valuation_type, std::size_t>;
+      std::unordered_map< valuation_type, std::size_t
+                        , std::hash<valuation_type>, std::equal_to<valuation_type>
+                        , mem::linear_alloc<map_value_type>>
+        group_of( head.size(), std::hash<valuation_type>(), std::equal_to<valuation_type>()
+                , mem::linear_alloc<map_value_type>(cxt.arena()));
+
+      std::size_t operand = 0;
+      for (auto operands_cit = begin; operands_cit != end; ++operands_cit, ++operand)
       {
-        // The current valuation may be modified, we need a copy.
-        auto current_val = alpha_cit->valuation();
-        auto current_succ = alpha_cit->successor();
-
-        // Initialize the start of the next search.
-        auto res_cit = res.begin();
+        // Throw a Top if operands are incompatible (different types or different variables).
+        check_compatibility(*begin, *operands_cit);
 
-        // (C). While the current valuation is not empty, test it against arcs in res.
-        while (not values::empty_values(current_val) and res_cit != res_end)
+        for (const auto& arc : mem::variant_cast<node_type>(**operands_cit))
         {
-          const valuation_type& res_val = res_cit->first;
-          sum_builder_type& res_succs = res_cit->second;
-
-          // (D).
-          if (current_val == res_val) // Same valuations.
+          const auto insertion = group_of.emplace(arc.valuation(), groups.size());
+          if (insertion.second)
           {
-            save.emplace_back(res_val, std::move(res_succs));
-            save.back().second.add(std::move(current_succ));
-            res_cit = res.erase(res_cit);
-            // Avoid useless insertion or temporary variables.
-            goto equality;
+            groups.push_back(block{arc.valuation(), sum_builder_type(cxt), operand});
           }
-
-          intersection_builder<C, valuation_type> inter_builder(cxt);
-          inter_builder.add(current_val);
-          inter_builder.add(res_val);
-          const valuation_type inter = intersection(cxt, std::move(inter_builder));
-
-          // (E). The current valuation and the current arc from res have a common part.
-          if (not values::empty_values(inter))
-          {
-            save.emplace_back(inter, res_succs);
-            save.back().second.add(current_succ);
-
-            // (F).
-            valuation_type diff = difference(cxt, res_val, inter);
-            if (not values::empty_values(diff))
-            {
-              // (res_val - inter) can't be in intersection, but we need to keep it
-              // for the next arcs of the current alpha. So we put it in a temporary storage.
-              // It will be added back in res when we have finished with the current valuation.
-              remainder.emplace_back(std::move(diff), std::move(res_succs));
-            }
-
-            // We won't need the current arc of res for the current val, we already have the
-            // common part. Now, the current valuation has to be tested against the next arcs
-            // of res.
-            res_cit = res.erase(res_cit);
-
-            // (G). The current valuation is completely included in the current arc of res.
-            if (current_val == inter)
-            {
-              // We can move to the next arc of the current operand.
-              break;
-            }
-
-            // Continue with what remains of val. If val is empty, the loop will stop at the
-            // next iteration.
-            current_val = difference(cxt, current_val, inter);
-          }
-          else // (H). Empty intersection, lookup for next possible common parts.
+          else
           {
-            ++res_cit;
+            groups[insertion.first->second].origin = several_operands;
           }
-        } // While we're not at the end of res and val is not empty.
+          groups[insertion.first->second].successors.add(arc.successor());
+        }
+      }
+    }
 
-        // (I). For val or a part of val (it could have been modified during the previous
-        // loop), we didn't find an intersection with any arc of res.
-        if (not values::empty_values(current_val))
+    // (B). Refine the partition with each group.
+    std::vector<block, mem::linear_alloc<block>> res(mem::linear_alloc<block>(cxt.arena()));
+    res.reserve(groups.size());
+    for (auto& group : groups)
+    {
+      const auto merge_successors = [&](sum_builder_type& succs)
+      {
+        for (const auto& succ : group.successors)
         {
-          sum_builder_type succs(cxt);
-          succs.add(std::move(current_succ));
-          save.emplace_back(std::move(current_val), std::move(succs));
+          succs.add(succ);
         }
+      };
 
-        // Both arcs had the same valuation.
-        equality:;
+      // Blocks added while refining with the current group are parts of it, no need to test them.
+      const auto res_size = res.size();
+      auto current_val = group.valuation;
+      bool covered = false;
+      for (std::size_t i = 0; i < res_size; ++i)
+      {
+        // (C). Arcs of the same operand are disjoint.
+        if (group.origin != several_operands and res[i].origin == group.origin)
+        {
+          continue;
+        }
+
+        intersection_builder<C, valuation_type> inter_builder(cxt);
+        inter_builder.add(current_val);
+        inter_builder.add(res[i].valuation);
+        valuation_type inter = intersection(cxt, std::move(inter_builder));
+        if (values::empty_values(inter))
+        {
+          continue;
+        }
 
-        // Reinject all parts that were removed in (F).
-        for (auto& rem : remainder)
+        const bool whole_current = inter == current_val;
+        if (not whole_current)
+        {
+          current_val = difference(cxt, current_val, inter);
+        }
+
+        if (inter == res[i].valuation)
+        {
+          // (D). The block is entirely covered by the current valuation.
+          merge_successors(res[i].successors);
+          res[i].origin = several_operands;
+        }
+        else
         {
-          res.emplace(std::move(rem.first), std::move(rem.second));
+          // (E). Split the block: the common part gets the successors of both.
+          auto succs = res[i].successors;
+          merge_successors(succs);
+          res[i].valuation = difference(cxt, res[i].valuation, inter);
+          res.push_back(block{std::move(inter), std::move(succs), several_operands});
         }
-        remainder.clear();
 
-      } // For each arc of the current operand.
+        // (F). The current valuation is completely included in the block.
+        if (whole_current)
+        {
+          covered = true;
+          break;
+        }
+      }
 
-      // Reinject all parts that were removed from res (all parts that have a non-empty
-      // intersection with the current alpha) and all parts of the current alpha that have an
-      // empty intersection with all the parts of res.
-      res.insert(save.begin(), save.end());
+      // (G). The remaining part doesn't intersect any block.
+      if (not covered)
+      {
+        res.push_back(block{std::move(current_val), std::move(group.successors), group.origin});
+      }
+    }
 
-      // We still need save.
-      save.clear();
-    } // End of iteration on operands.
+    // The unions of successors are independent, they can be evaluated in parallel.
+    std::vector<SDD<C>, mem::linear_alloc<SDD<C>>>
+      succs(res.size(), mem::linear_alloc<SDD<C>>(cxt.arena()));
+    cxt.parallel_for(res.size(), [&](context<C>& local_cxt, std::size_t i)
+    {
+      succs[i] = sum(local_cxt, std::move(res[i].successors));
+    });
 
     square_union<C, valuation_type> su(cxt);
     su.reserve(res.size());
-    for (auto& arc : res)
+    for (std::size_t i = 0; i < res.size(); ++i)
     {
       // construct an operand for the square union: (successors union) --> valuation
-      su.add(sum(cxt, std::move(arc.second)), std::move(arc.first));
+      su.add(std::move(succs[i]), std::move(res[i].valuation));
     }
 
     return SDD<C>(head.variable(), su());
@@ -269,9 +251,19 @@ struct LIBSDD_ATTRIBUTE_PACKED sum_op_impl
       succ_to_value( std::less<SDD<C>>()
                    , mem::linear_alloc<std::pair<SDD<C>, values_builder>>(cxt.arena()));
     succ_to_value.reserve(value_to_succ.size());
+
+    // The unions of successors are independent, they can be evaluated in parallel.
+    std::vector<SDD<C>, mem::linear_alloc<SDD<C>>>
+      succs(value_to_succ.size(), mem::linear_alloc<SDD<C>>(cxt.arena()));
+    cxt.parallel_for(value_to_succ.size(), [&](context<C>& local_cxt, std::size_t i)
+    {
+      succs[i] = sum(local_cxt, std::move((value_to_succ.begin() + i)->second));
+    });
+
+    auto succ_cit = succs.begin();
     for (auto& value_succs : value_to_succ)
     {
-      const SDD<C> succ = sum(cxt, std::move(value_succs.second));
+      SDD<C>& succ = *succ_cit++;
       const auto search = succ_to_value.find(succ);
       if (search == succ_to_value.end())
       {
@@ -331,7 +323,7 @@ sum(context<C>& cxt, sum_builder<C, SDD<C>>&& builder)
   {
     return *builder.begin();
   }
-  return cxt.sum_cache()({builder});
+  return cxt.sum_cache()(cxt, {builder});
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -12,6 +12,7 @@
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/evaluation.hh"
+#include "sdd/hom/fixpoint_strategy.hh"
 #include "sdd/hom/rewrite.hh"
 #include "sdd/mem/cache.hh"
 
@@ -30,7 +31,8 @@ class context
 public:
 
   /// @brief Homomorphism evaluation cache type.
-  using cache_type = mem::cache< context, cached_homomorphism<C>, should_cache<C>>;
+  using cache_type =
+    typename C::template cache_type<context, cached_homomorphism<C>, should_cache<C>>;
 
   /// @brief SDD operation context type.
   using sdd_context_type = sdd::dd::context<C>;
@@ -45,17 +47,66 @@ private:
   /// It already implements cheap-copy, we don't need to use a shared_ptr.
   sdd_context_type sdd_context_;
 
+  /// @brief How fixpoints are evaluated.
+  sdd::fixpoint_strategy fixpoint_strategy_;
+
+  /// @brief Statistics of fixpoint evaluations.
+  std::shared_ptr<fixpoint_recorder> fixpoint_stats_;
+
+  /// @brief The maximal number of images cached by each Function.
+  std::size_t function_cache_size_;
+
 public:
 
   /// @brief Construct a new context.
-  context(std::size_t size, sdd_context_type& sdd_cxt)
+  context( std::size_t size, sdd_context_type& sdd_cxt
+         , sdd::fixpoint_strategy strategy = sdd::fixpoint_strategy::accumulate
+         , std::size_t function_cache_size = 0)
    	: cache_(std::make_shared<cache_type>(*this, size))
     , sdd_context_(sdd_cxt)
+    , fixpoint_strategy_(strategy)
+    , fixpoint_stats_(std::make_shared<fixpoint_recorder>())
+    , function_cache_size_(function_cache_size)
   {}
 
   /// @brief Copy constructor.
   context(const context&) = default;
 
+  /// @brief Construct the context of a worker of the parallel evaluation engine.
+  ///
+  /// It shares the cache of other, but uses the context of SDD operations of the worker.
+  context(const context& other, const sdd_context_type& worker_sdd_cxt)
+    : cache_(other.cache_)
+    , sdd_context_(worker_sdd_cxt)
+    , fixpoint_strategy_(other.fixpoint_strategy_)
+    , fixpoint_stats_(other.fixpoint_stats_)
+    , function_cache_size_(other.function_cache_size_)
+  {}
+
+  /// @brief Evaluate f(cxt, i) for each i in [0, nb_tasks), where cxt is the context to use.
+  /// @see dd::context::parallel_for()
+  template <typename Function>
+  void
+  parallel_for(std::size_t nb_tasks, Function&& f)
+  {
+    sdd_context_.parallel_for(nb_tasks, [&](sdd_context_type& sdd_cxt, std::size_t i)
+    {
+      call(sdd_cxt, f, i);
+    });
+  }
+
+  /// @brief Evaluate f(cxt, i) for each i in [0, nb_tasks), with a specific threshold.
+  /// @see dd::context::parallel_for()
+  template <typename Function>
+  void
+  parallel_for(std::size_t nb_tasks, std::size_t threshold, Function&& f)
+  {
+    sdd_context_.parallel_for(nb_tasks, threshold, [&](sdd_context_type& sdd_cxt, std::size_t i)
+    {
+      call(sdd_cxt, f, i);
+    });
+  }
+
   /// @brief Return the cache of homomorphism evaluation.
   cache_type&
   cache()
@@ -72,6 +123,30 @@ public:
     return sdd_context_;
   }
 
+  /// @brief Return how fixpoints are evaluated.
+  sdd::fixpoint_strategy
+  fixpoint_strategy()
+  const noexcept
+  {
+    return fixpoint_strategy_;
+  }
+
+  /// @brief Return the statistics of fixpoint evaluations.
+  fixpoint_recorder&
+  fixpoint_stats()
+  noexcept
+  {
+    return *fixpoint_stats_;
+  }
+
+  /// @brief Return the maximal number of images cached by each Function.
+  std::size_t
+  function_cache_size()
+  const noexcept
+  {
+    return function_cache_size_;
+  }
+
   /// @brief Remove all cache entries of this context.
   void
   clear()
@@ -79,6 +154,24 @@ public:
   {
     cache_->clear();
   }
+
+private:
+
+  /// @brief Call f with the context which corresponds to an SDD operations context.
+  template <typename Function>
+  void
+  call(sdd_context_type& sdd_cxt, Function& f, std::size_t i)
+  {
+    if (&sdd_cxt == &sdd_context_) // Evaluated sequentially, by the calling thread.
+    {
+      f(*this, i);
+    }
+    else
+    {
+      context worker_cxt(*this, sdd_cxt);
+      f(worker_cxt, i);
+    }
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
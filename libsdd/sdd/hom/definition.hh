@@ -23,16 +23,61 @@
 #include "sdd/hom/inductive.hh"
 #include "sdd/hom/intersection.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/hom/relation.hh"
 #include "sdd/hom/saturation_fixpoint.hh"
 #include "sdd/hom/saturation_intersection.hh"
 #include "sdd/hom/saturation_sum.hh"
 #include "sdd/hom/sum.hh"
 #include "sdd/mem/ptr.hh"
+#include "sdd/mem/sharded_unique_table.hh"
 #include "sdd/mem/unique.hh"
 #include "sdd/mem/variant.hh"
+#include "sdd/util/typelist.hh"
 
 namespace sdd {
 
+namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The variant of all types of homomorphisms.
+///
+/// User's types listed in C::inductive_types and C::function_types are stored directly in this
+/// variant. Note that the size of the largest type is allocated for each homomorphism.
+template < typename C
+         , typename Inductives = typename C::inductive_types
+         , typename Functions = typename C::function_types>
+struct homomorphism_types;
+
+/// @internal
+template <typename C, typename... Inductives, typename... Functions>
+struct homomorphism_types<C, util::list<Inductives...>, util::list<Functions...>>
+{
+  using type = mem::variant< _composition<C>
+                           , _cons<C, SDD<C>>
+                           , _cons<C, typename C::Values>
+                           , _constant<C>
+                           , _fixpoint<C>
+                           , _function<C>
+                           , _identity<C>
+                           , _if_then_else<C>
+                           , _inductive<C>
+                           , _intersection<C>
+                           , _local<C>
+                           , _relation<C>
+                           , _saturation_fixpoint<C>
+                           , _saturation_intersection<C>
+                           , _saturation_sum<C>
+                           , _sum<C>
+                           , _static_inductive<C, Inductives>...
+                           , _static_function<C, Functions>...>;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace hom
+
 /*------------------------------------------------------------------------------------------------*/
 
 /// @brief An homomorphism operation.
@@ -42,21 +87,7 @@ class homomorphism final
 private:
 
   /// @brief A canonized homomorphism.
-  using data_type =  mem::variant< hom::_composition<C>
-                                 , hom::_cons<C, SDD<C>>
-                                 , hom::_cons<C, typename C::Values>
-                                 , hom::_constant<C>
-                                 , hom::_fixpoint<C>
-                                 , hom::_function<C>
-                                 , hom::_identity<C>
-                                 , hom::_if_then_else<C>
-                                 , hom::_inductive<C>
-                                 , hom::_intersection<C>
-                                 , hom::_local<C>
-                                 , hom::_saturation_fixpoint<C>
-                                 , hom::_saturation_intersection<C>
-                                 , hom::_saturation_sum<C>
-                                 , hom::_sum<C>>;
+  using data_type = typename hom::homomorphism_types<C>::type;
 
 public:
 
@@ -64,14 +95,15 @@ public:
   /// @brief A unified and canonized homomorphism, meant to be stored in a unique table.
   ///
   /// It is automatically erased when there is no more reference to it.
-  using unique_type = mem::unique<data_type>;
+  using unique_type = mem::unique<data_type, typename C::reference_counter_type>;
 
   /// @internal
   /// @brief Define the smart pointer around a unified homomorphism.
   ///
   /// It handles the reference counting as well as the deletion of the homomorphism when it is
   /// no longer referenced.
-  using ptr_type = mem::ptr<unique_type>;
+  using ptr_type =
+    mem::ptr<unique_type, mem::table_deleter<typename C::template unique_table_type<unique_type>>>;
 
 private:
 
@@ -201,7 +233,7 @@ public:
     // - if the current operand is |0|, then directly return it
     return *this == id<C>() or x.empty()
          ? x
-         : cxt.cache()({o, *this, std::forward<SDD_>(x)});
+         : cxt.cache()(cxt, {o, *this, std::forward<SDD_>(x)});
   }
 
   /// @brief Equality.
@@ -259,11 +291,10 @@ homomorphism<C>
 make_variable_size(std::size_t extra_bytes, Args&&... args)
 {
   using unique_type = typename homomorphism<C>::unique_type;
-  using ptr_type = typename homomorphism<C>::ptr_type;
   auto& ut = global<C>().hom_unique_table;
   char* addr = ut.allocate(extra_bytes);
   unique_type* u = new (addr) unique_type(mem::construct<T>(), std::forward<Args>(args)...);
-  return {ptr_type(&ut(u, extra_bytes))};
+  return {mem::make_ptr(ut, u, extra_bytes)};
 }
 
 /// @internal
@@ -6,13 +6,19 @@
 
 #pragma once
 
+#include <algorithm> // copy_if, find
 #include <iosfwd>
+#include <iterator>  // back_inserter
+#include <vector>
 
 #include "sdd/dd/definition.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
+#include "sdd/hom/fixpoint_strategy.hh"
 #include "sdd/hom/identity.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/hom/sum.hh"
+#include "sdd/mem/linear_alloc.hh"
 #include "sdd/order/order.hh"
 
 namespace sdd {
@@ -26,6 +32,99 @@ namespace hom {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Compute all states reachable from x with the frontier or the chaining strategy.
+/// @param begin, end The operands which compute successor states, Id is ignored.
+/// @param closure Complete a set of new states with the states it reaches with other operands,
+/// it's called as closure(new_states, applications) and must return a superset of new_states.
+///
+/// Operands are never applied twice to the same state, which requires them to be linear.
+template <typename C, typename InputIterator, typename Closure>
+SDD<C>
+reachable( context<C>& cxt, const order<C>& o, const SDD<C>& x
+         , InputIterator begin, InputIterator end, Closure&& closure)
+{
+  auto& sdd_cxt = cxt.sdd_context();
+  const auto union_of = [&](const SDD<C>& lhs, const SDD<C>& rhs)
+  {
+    return dd::sum(sdd_cxt, dd::sum_builder<C, SDD<C>>(sdd_cxt, {lhs, rhs}));
+  };
+
+  fixpoint_iterations iterations(cxt.fixpoint_stats());
+  std::size_t applications = 0;
+
+  SDD<C> reached = closure(x, applications);
+  SDD<C> frontier = reached;
+
+  if (cxt.fixpoint_strategy() == fixpoint_strategy::chaining)
+  {
+    while (not frontier.empty())
+    {
+      // Each operand sees the states discovered by the previous ones.
+      SDD<C> discovered = zero<C>();
+      for (auto cit = begin; cit != end; ++cit)
+      {
+        if (*cit == id<C>())
+        {
+          continue;
+        }
+        auto new_states = dd::difference(sdd_cxt, (*cit)(cxt, o, frontier), reached);
+        applications += 1;
+        if (not new_states.empty())
+        {
+          new_states = dd::difference(sdd_cxt, closure(new_states, applications), reached);
+          reached = union_of(reached, new_states);
+          frontier = union_of(frontier, new_states);
+          discovered = union_of(discovered, new_states);
+        }
+      }
+      frontier = discovered;
+      iterations.next(applications);
+      applications = 0;
+    }
+  }
+  else
+  {
+    mem::rewinder _(sdd_cxt.arena());
+    std::vector<homomorphism<C>, mem::linear_alloc<homomorphism<C>>>
+      operands(mem::linear_alloc<homomorphism<C>>(sdd_cxt.arena()));
+    std::copy_if( begin, end, std::back_inserter(operands)
+                , [](const homomorphism<C>& h){return h != id<C>();});
+
+    while (not frontier.empty())
+    {
+      mem::rewinder _(sdd_cxt.arena());
+
+      // All operands see the same frontier, their applications are independent.
+      std::vector<SDD<C>, mem::linear_alloc<SDD<C>>>
+        images(operands.size(), mem::linear_alloc<SDD<C>>(sdd_cxt.arena()));
+      cxt.parallel_for(operands.size(), 2, [&](context<C>& local_cxt, std::size_t i)
+      {
+        images[i] = operands[i](local_cxt, o, frontier);
+      });
+      applications += operands.size();
+
+      dd::sum_builder<C, SDD<C>> image(sdd_cxt);
+      image.reserve(images.size());
+      for (auto& img : images)
+      {
+        image.add(std::move(img));
+      }
+      frontier = dd::difference(sdd_cxt, dd::sum(sdd_cxt, std::move(image)), reached);
+      if (not frontier.empty())
+      {
+        frontier = dd::difference(sdd_cxt, closure(frontier, applications), reached);
+        reached = union_of(reached, frontier);
+      }
+      iterations.next(applications);
+      applications = 0;
+    }
+  }
+  return reached;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 /// @brief Fixpoint homomorphism.
 template <typename C>
@@ -35,16 +134,31 @@ struct _fixpoint
   const homomorphism<C> h;
 
   /// @brief Evaluation.
+  ///
+  /// If h is a sum which contains Id, the fixpoint computes all reachable states, thus the
+  /// strategy of the context can be used.
   SDD<C>
   operator()(context<C>& cxt, const order<C>& o, const SDD<C>& x)
   const
   {
+    if (cxt.fixpoint_strategy() != fixpoint_strategy::accumulate and mem::is<_sum<C>>(h))
+    {
+      const auto& s = mem::variant_cast<const _sum<C>>(*h);
+      if (std::find(s.begin(), s.end(), id<C>()) != s.end())
+      {
+        return reachable( cxt, o, x, s.begin(), s.end()
+                        , [](const SDD<C>& states, std::size_t&){return states;});
+      }
+    }
+
+    fixpoint_iterations iterations(cxt.fixpoint_stats());
     SDD<C> x1 = x;
     SDD<C> x2 = x1;
     do
     {
       x2 = x1;
       swap(x1, h(cxt, o, x1));
+      iterations.next(1);
     } while (x1 != x2);
     return x1;
   }
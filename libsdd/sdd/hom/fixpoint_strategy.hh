@@ -0,0 +1,170 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <chrono>
+#include <cstddef> // size_t
+#include <mutex>
+#include <vector>
+
+namespace sdd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief How Fixpoint and Saturation Fixpoint homomorphisms are evaluated.
+///
+/// The frontier and chaining strategies only apply to fixpoints whose operand contains Id, that
+/// is to fixpoints which compute all reachable states. Other fixpoints are always evaluated with
+/// the accumulate strategy.
+enum class fixpoint_strategy
+{
+  /// @brief Operands are applied to all states found so far, until they no longer change.
+  accumulate,
+
+  /// @brief Operands are only applied to the states discovered by the previous iteration.
+  frontier,
+
+  /// @brief As frontier, but each operand is also applied to the states discovered by the
+  /// operands applied before it in the same iteration.
+  chaining
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief The statistics of an iteration rank of fixpoint evaluations.
+struct fixpoint_iteration_statistics
+{
+  /// @brief The number of fixpoint evaluations which performed this iteration.
+  std::size_t count;
+
+  /// @brief The number of operands applications during this iteration.
+  std::size_t applications;
+
+  /// @brief The time spent in this iteration, including nested fixpoints.
+  std::chrono::nanoseconds duration;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief The statistics of fixpoint evaluations.
+struct fixpoint_statistics
+{
+  /// @brief The number of evaluations of Fixpoint and Saturation Fixpoint homomorphisms.
+  std::size_t evaluations;
+
+  /// @brief The statistics of each iteration rank.
+  ///
+  /// The first element cumulates the first iteration of all evaluations, the second one their
+  /// second iteration, and so on.
+  std::vector<fixpoint_iteration_statistics> iterations;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace hom {
+
+/// @internal
+/// @brief Record the statistics of fixpoint evaluations.
+///
+/// It's shared by all threads which evaluate homomorphisms.
+class fixpoint_recorder
+{
+private:
+
+  /// @brief Protect statistics from concurrent evaluations.
+  mutable std::mutex mutex_;
+
+  /// @brief The recorded statistics.
+  fixpoint_statistics stats_;
+
+public:
+
+  /// @brief Default constructor.
+  fixpoint_recorder()
+    : mutex_(), stats_{0, {}}
+  {}
+
+  /// @brief Record the beginning of a fixpoint evaluation.
+  void
+  evaluation()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.evaluations += 1;
+  }
+
+  /// @brief Record an iteration of a fixpoint evaluation.
+  /// @param rank The number of previous iterations of the same evaluation.
+  void
+  iteration(std::size_t rank, std::size_t applications, std::chrono::nanoseconds duration)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stats_.iterations.size() <= rank)
+    {
+      stats_.iterations.resize(rank + 1, {0, 0, std::chrono::nanoseconds::zero()});
+    }
+    auto& it = stats_.iterations[rank];
+    it.count += 1;
+    it.applications += applications;
+    it.duration += duration;
+  }
+
+  /// @brief Get a copy of the recorded statistics.
+  fixpoint_statistics
+  statistics()
+  const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+  }
+
+  /// @brief Forget all recorded statistics.
+  void
+  clear()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = {0, {}};
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Measure the iterations of a fixpoint evaluation.
+class fixpoint_iterations
+{
+private:
+
+  fixpoint_recorder& recorder_;
+
+  /// @brief The rank of the current iteration.
+  std::size_t rank_;
+
+  /// @brief The start of the current iteration.
+  std::chrono::steady_clock::time_point start_;
+
+public:
+
+  /// @brief Start the first iteration of a new fixpoint evaluation.
+  fixpoint_iterations(fixpoint_recorder& recorder)
+    : recorder_(recorder), rank_(0), start_(std::chrono::steady_clock::now())
+  {
+    recorder_.evaluation();
+  }
+
+  /// @brief Terminate the current iteration and start the next one.
+  void
+  next(std::size_t applications)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    recorder_.iteration(rank_++, applications, now - start_);
+    start_ = now;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::hom
@@ -6,23 +6,116 @@
 
 #pragma once
 
-#include <algorithm> // find
+#include <algorithm>     // find
 #include <iosfwd>
-#include <memory>    // unique_ptr
-#include <typeinfo>  // typeid
+#include <memory>        // unique_ptr
+#include <mutex>
+#include <type_traits>   // decay_t, false_type, true_type
+#include <typeinfo>      // typeid
+#include <unordered_map>
+#include <vector>
 
 #include "sdd/dd/definition.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
+#include "sdd/mem/linear_alloc.hh"
 #include "sdd/util/packed.hh"
 #include "sdd/order/carrier.hh"
 #include "sdd/order/order.hh"
 #include "sdd/order/order_node.hh"
+#include "sdd/util/typelist.hh"
 
 namespace sdd { namespace hom {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Cache the images of values by a user's function.
+///
+/// Unified values, like flat_set, are hashed and compared with their address. When it's full, the
+/// cache is emptied.
+template <typename C, bool ThreadSafe = C::thread_safe>
+class function_cache
+{
+public:
+
+  /// @brief The type of a set of values.
+  using values_type = typename C::Values;
+
+private:
+
+  /// @brief The images of values.
+  std::unordered_map<values_type, values_type> images_;
+
+public:
+
+  /// @brief Look for the image of a set of values.
+  /// @return false if it's not in the cache.
+  bool
+  find(const values_type& val, values_type& image)
+  const
+  {
+    const auto search = images_.find(val);
+    if (search == images_.end())
+    {
+      return false;
+    }
+    image = search->second;
+    return true;
+  }
+
+  /// @brief Store the image of a set of values.
+  void
+  insert(const values_type& val, const values_type& image, std::size_t max_size)
+  {
+    if (images_.size() >= max_size)
+    {
+      images_.clear();
+    }
+    images_.emplace(val, image);
+  }
+};
+
+/// @internal
+/// @brief Cache the images of values by a user's function, for thread-safe configurations.
+template <typename C>
+class function_cache<C, true>
+{
+public:
+
+  /// @brief The type of a set of values.
+  using values_type = typename C::Values;
+
+private:
+
+  /// @brief Protect the cache.
+  mutable std::mutex mutex_;
+
+  /// @brief The wrapped cache.
+  function_cache<C, false> cache_;
+
+public:
+
+  /// @brief Look for the image of a set of values.
+  bool
+  find(const values_type& val, values_type& image)
+  const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cache_.find(val, image);
+  }
+
+  /// @brief Store the image of a set of values.
+  void
+  insert(const values_type& val, const values_type& image, std::size_t max_size)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.insert(val, image, max_size);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 template <typename C>
 struct function_base
@@ -30,6 +123,9 @@ struct function_base
   /// @brief The type of a set of values.
   using values_type = typename C::Values;
 
+  /// @brief The images already computed by the user's function.
+  mutable function_cache<C> cache;
+
   /// @brief Destructor.
   virtual
   ~function_base()
@@ -50,6 +146,11 @@ struct function_base
   values_type
   operator()(const values_type&) const = 0;
 
+  /// @brief Apply the user function on several sets of values at once.
+  virtual
+  void
+  operator()(const values_type* begin, const values_type* end, values_type* images) const = 0;
+
   /// @brief Compare values_base.
   virtual
   bool
@@ -70,7 +171,7 @@ struct function_base
 
 /// @internal
 template <typename C, typename User>
-struct function_derived
+struct function_derived final
   : public function_base<C>
 {
   /// @brief The user's values function.
@@ -108,6 +209,14 @@ struct function_derived
     return fun(val);
   }
 
+  /// @brief Apply the user function on several sets of values at once.
+  void
+  operator()(const values_type* begin, const values_type* end, values_type* images)
+  const override
+  {
+    bulk_impl(fun, begin, end, images, 0);
+  }
+
   /// @brief Compare values_derived.
   bool
   operator==(const function_base<C>& other)
@@ -183,6 +292,28 @@ private:
     return false;
   }
 
+  /// @brief Called when the user's function handles several sets of values at once.
+  ///
+  /// Compile-time dispatch.
+  template <typename T>
+  static auto
+  bulk_impl(const T& x, const values_type* begin, const values_type* end, values_type* images, int)
+  -> decltype(x(begin, end, images))
+  {
+    return x(begin, end, images);
+  }
+
+  /// @brief Called when the user's function handles one set of values at a time.
+  ///
+  /// Compile-time dispatch.
+  template <typename T>
+  static auto
+  bulk_impl(const T& x, const values_type* begin, const values_type* end, values_type* images, long)
+  -> decltype(void())
+  {
+    std::transform(begin, end, images, [&](const values_type& val){return x(val);});
+  }
+
   /// @brief Called when the user's function has operator<<(ostream&).
   ///
   /// Compile-time dispatch.
@@ -208,6 +339,52 @@ private:
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Compute the images of all valuations of a node by a user's function.
+/// @param cache_size The maximal number of images kept in the cache, 0 disables it.
+///
+/// The user function is called only once, with the valuations which are not in the cache.
+template <typename Function, typename Node, typename Images>
+void
+function_images( const Function& fun, const Node& node, mem::arena& a, std::size_t cache_size
+               , Images& res)
+{
+  using values_type = typename Function::values_type;
+
+  res.resize(node.size());
+  std::vector<values_type, mem::linear_alloc<values_type>>
+    missing(mem::linear_alloc<values_type>{a});
+  std::vector<std::size_t, mem::linear_alloc<std::size_t>>
+    positions(mem::linear_alloc<std::size_t>{a});
+  for (std::size_t i = 0; i < node.size(); ++i)
+  {
+    const auto& val = node.begin()[i].valuation();
+    if (cache_size == 0 or not fun.cache.find(val, res[i]))
+    {
+      missing.push_back(val);
+      positions.push_back(i);
+    }
+  }
+  if (missing.empty())
+  {
+    return;
+  }
+
+  std::vector<values_type, mem::linear_alloc<values_type>>
+    missing_images(missing.size(), mem::linear_alloc<values_type>{a});
+  fun(missing.data(), missing.data() + missing.size(), missing_images.data());
+  for (std::size_t i = 0; i < missing.size(); ++i)
+  {
+    if (cache_size != 0)
+    {
+      fun.cache.insert(missing[i], missing_images[i], cache_size);
+    }
+    res[positions[i]] = std::move(missing_images[i]);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 template <typename C>
 struct LIBSDD_ATTRIBUTE_PACKED _function
@@ -225,8 +402,9 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
   struct evaluation
   {
     /// @brief |0| case, should never happen.
+    template <typename Function>
     SDD<C>
-    operator()(const zero_terminal<C>&, const function_base<C>&, context<C>&, const order<C>&)
+    operator()(const zero_terminal<C>&, const Function&, context<C>&, const order<C>&)
     const noexcept
     {
       assert(false);
@@ -234,16 +412,18 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
     }
 
     /// @brief |1| case.
+    template <typename Function>
     SDD<C>
-    operator()(const one_terminal<C>&, const function_base<C>&, context<C>&, const order<C>&)
+    operator()(const one_terminal<C>&, const Function&, context<C>&, const order<C>&)
     const
     {
       return one<C>();
     }
 
     /// @brief A function can't be applied on an hierarchical node.
+    template <typename Function>
     SDD<C>
-    operator()(const hierarchical_node<C>&, const function_base<C>&, context<C>&, const order<C>&)
+    operator()(const hierarchical_node<C>&, const Function&, context<C>&, const order<C>&)
     const
     {
       assert(false && "Apply function on an hierarchical node");
@@ -251,18 +431,26 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
     }
 
     /// @brief Evaluation on a flat node.
+    template <typename Function>
     SDD<C>
-    operator()( const flat_node<C>& node, const function_base<C>& fun, context<C>& cxt
+    operator()( const flat_node<C>& node, const Function& fun, context<C>& cxt
               , const order<C>& o)
     const
     {
+      auto& arena = cxt.sdd_context().arena();
+      mem::rewinder _(arena);
+      std::vector<values_type, mem::linear_alloc<values_type>>
+        images(mem::linear_alloc<values_type>{arena});
+      function_images(fun, node, arena, cxt.function_cache_size(), images);
+
+      auto image = images.begin();
       if (fun.selector() or fun.shifter())
       {
         dd::alpha_builder<C, values_type> alpha_builder(cxt.sdd_context());
         alpha_builder.reserve(node.size());
         for (const auto& arc : node)
         {
-          values_type val = fun(arc.valuation());
+          values_type val = std::move(*image++);
           if (not val.empty())
           {
             alpha_builder.add(std::move(val), arc.successor());
@@ -276,7 +464,7 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
         sum_operands.reserve(node.size());
         for (const auto& arc : node)
         {
-          sum_operands.add(SDD<C>(o.variable(), fun(arc.valuation()), arc.successor()));
+          sum_operands.add(SDD<C>(o.variable(), std::move(*image++), arc.successor()));
         }
         return dd::sum(cxt.sdd_context(), std::move(sum_operands));
       }
@@ -327,6 +515,89 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Function homomorphism of a user's type listed in C::function_types.
+///
+/// The user's function is directly stored in the homomorphism, thus calls to it are not virtual.
+template <typename C, typename User>
+struct _static_function
+{
+  /// @brief The identifier on which the user function is applied.
+  const typename C::variable_type target;
+
+  /// @brief The user's values function.
+  const function_derived<C, User> fun;
+
+  /// @brief Constructor.
+  _static_function(typename C::variable_type var, User u)
+    : target(var), fun(std::move(u))
+  {}
+
+  /// @brief Skip variable predicate.
+  bool
+  skip(const order<C>& o)
+  const noexcept
+  {
+    return target != o.variable();
+  }
+
+  /// @brief Selector predicate
+  bool
+  selector()
+  const noexcept
+  {
+    return fun.selector();
+  }
+
+  /// @brief Evaluation.
+  SDD<C>
+  operator()(context<C>& cxt, const order<C>& o, const SDD<C>& x)
+  const
+  {
+    return visit(typename _function<C>::evaluation(), x, fun, cxt, o);
+  }
+
+  friend
+  bool
+  operator==(const _static_function& lhs, const _static_function& rhs)
+  noexcept
+  {
+    return lhs.target == rhs.target and lhs.fun.fun == rhs.fun.fun;
+  }
+
+  friend
+  std::ostream&
+  operator<<(std::ostream& os, const _static_function& x)
+  {
+    os << "fun(" << x.target << ", ";
+    x.fun.print(os);
+    return os << ")";
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Create a Function homomorphism of a user's type unknown to the configuration.
+template <typename C, typename User>
+homomorphism<C>
+make_function(typename C::variable_type var, User&& u, std::false_type)
+{
+  return make<C, _function<C>>
+    (var, std::make_unique<function_derived<C, User>>(std::forward<User>(u)));
+}
+
+/// @internal
+/// @brief Create a Function homomorphism of a user's type listed in C::function_types.
+template <typename C, typename User>
+homomorphism<C>
+make_function(typename C::variable_type var, User&& u, std::true_type)
+{
+  return make<C, _static_function<C, std::decay_t<User>>>(var, std::forward<User>(u));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 } // namespace hom
 
 /*------------------------------------------------------------------------------------------------*/
@@ -337,14 +608,22 @@ struct LIBSDD_ATTRIBUTE_PACKED _function
 ///
 /// If the target is in a nested hierarchy, the succession of Local to access it is automatically
 /// created.
+///
+/// The user's function is called with a const C::Values& and returns the new C::Values. It can
+/// also provide void operator()(const C::Values* begin, const C::Values* end, C::Values* images),
+/// which is then called once with all the valuations of a node which are not in the cache of
+/// this Function (see hom_function_cache_size).
+///
+/// If User belongs to C::function_types, u is stored in the homomorphism rather than behind a
+/// pointer, and its operations are not virtual calls.
 template <typename C, typename User>
 homomorphism<C>
 function(const order<C>& o, const typename C::Identifier& id, User&& u)
 {
   /// @todo Check that id is a flat identifier.
   const auto var = o.node(id).variable();
-  const auto f = hom::make<C, hom::_function<C>>
-    (var, std::make_unique<hom::function_derived<C, User>>(std::forward<User>(u)));
+  const auto f = hom::make_function<C>
+    (var, std::forward<User>(u), util::contains<std::decay_t<User>, typename C::function_types>{});
   return carrier(o, id, std::move(f));
 }
 
@@ -372,4 +651,20 @@ struct hash<sdd::hom::_function<C>>
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Hash specialization for sdd::hom::_static_function.
+template <typename C, typename User>
+struct hash<sdd::hom::_static_function<C, User>>
+{
+  std::size_t
+  operator()(const sdd::hom::_static_function<C, User>& x)
+  const noexcept
+  {
+    using namespace sdd::hash;
+    return seed(x.fun.hash()) (val(x.target));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 } // namespace std
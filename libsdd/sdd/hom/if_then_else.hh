@@ -41,6 +41,13 @@ struct _if_then_else
     // Apply predicate.
     const auto tmp = h_if(cxt, o, s);
 
+    // The rejected part is kept as is, thus it's not computed before its union with the
+    // accepted part.
+    if (h_else == id<C>())
+    {
+      return dd::difference_sum(cxt.sdd_context(), s, tmp, h_then(cxt, o, tmp));
+    }
+
     dd::sum_builder<C, SDD<C>> sum_operands(cxt.sdd_context());
     sum_operands.reserve(2);
 
@@ -8,14 +8,16 @@
 
 #include <cassert>
 #include <iosfwd>
-#include <memory>   // unique_ptr
-#include <typeinfo> // typeid
+#include <memory>      // unique_ptr
+#include <type_traits> // false_type, true_type
+#include <typeinfo>    // typeid
 
 #include "sdd/dd/definition.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/util/packed.hh"
 #include "sdd/order/order.hh"
+#include "sdd/util/typelist.hh"
 
 namespace sdd { namespace hom {
 
@@ -80,7 +82,7 @@ struct inductive_base
 /// @internal
 /// @brief Used to wrap user's inductive homomorphisms.
 template <typename C, typename User>
-struct inductive_derived
+struct inductive_derived final
   : public inductive_base<C>
 {
   /// @brief The user's inductive homomorphism.
@@ -252,24 +254,26 @@ struct _inductive
     const order<C>& order_;
     const SDD<C> sdd_;
 
+    template <typename Inductive>
     SDD<C>
-    operator()(const zero_terminal<C>&, const inductive_base<C>&)
+    operator()(const zero_terminal<C>&, const Inductive&)
     const noexcept
     {
       assert(false);
       __builtin_unreachable();
     }
 
+    template <typename Inductive>
     SDD<C>
-    operator()(const one_terminal<C>& one, const inductive_base<C>& i)
+    operator()(const one_terminal<C>& one, const Inductive& i)
     const
     {
       return i(one);
     }
 
-    template <typename Node>
+    template <typename Node, typename Inductive>
     SDD<C>
-    operator()(const Node& node, const inductive_base<C>& inductive)
+    operator()(const Node& node, const Inductive& inductive)
     const
     {
       dd::sum_builder<C, SDD<C>> sum_operands(cxt_.sdd_context());
@@ -326,17 +330,98 @@ struct _inductive
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief inductive homomorphism of a user's type listed in C::inductive_types.
+///
+/// The user's inductive is directly stored in the homomorphism, thus calls to it are not virtual.
+template <typename C, typename User>
+struct _static_inductive
+{
+  /// @brief The user's inductive homomorphism.
+  const inductive_derived<C, User> h;
+
+  /// @brief Constructor.
+  _static_inductive(const User& u)
+    : h(u)
+  {}
+
+  /// @brief Evaluation.
+  SDD<C>
+  operator()(context<C>& cxt, const order<C>& o, const SDD<C>& s)
+  const
+  {
+    return visit(typename _inductive<C>::evaluation{cxt, o, s}, s, h);
+  }
+
+  /// @brief Skip predicate.
+  bool
+  skip(const order<C>& o)
+  const noexcept
+  {
+    return h.skip(o);
+  }
+
+  /// @brief Selector predicate
+  bool
+  selector()
+  const noexcept
+  {
+    return h.selector();
+  }
+
+  friend
+  bool
+  operator==(const _static_inductive& lhs, const _static_inductive& rhs)
+  noexcept
+  {
+    return lhs.h.h == rhs.h.h;
+  }
+
+  friend
+  std::ostream&
+  operator<<(std::ostream& os, const _static_inductive& i)
+  {
+    i.h.print(os);
+    return os;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Create an inductive homomorphism of a user's type unknown to the configuration.
+template <typename C, typename User>
+homomorphism<C>
+make_inductive(const User& u, std::false_type)
+{
+  return make<C, _inductive<C>>(std::make_unique<inductive_derived<C, User>>(u));
+}
+
+/// @internal
+/// @brief Create an inductive homomorphism of a user's type listed in C::inductive_types.
+template <typename C, typename User>
+homomorphism<C>
+make_inductive(const User& u, std::true_type)
+{
+  return make<C, _static_inductive<C, User>>(u);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 } // namespace hom
 
 /*------------------------------------------------------------------------------------------------*/
 
 /// @brief Create the inductive homomorphism.
 /// @related homomorphism
+///
+/// If User belongs to C::inductive_types, u is stored in the homomorphism rather than behind a
+/// pointer, and its operations are not virtual calls.
 template <typename C, typename User>
 homomorphism<C>
 inductive(const User& u)
 {
-  return hom::make<C, hom::_inductive<C>>(std::make_unique<hom::inductive_derived<C, User>>(u));
+  return hom::make_inductive<C>(u, util::contains<User, typename C::inductive_types>{});
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -362,4 +447,19 @@ struct hash<sdd::hom::_inductive<C>>
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Hash specialization for sdd::hom::_static_inductive.
+template <typename C, typename User>
+struct hash<sdd::hom::_static_inductive<C, User>>
+{
+  std::size_t
+  operator()(const sdd::hom::_static_inductive<C, User>& i)
+  const
+  {
+    return i.h.hash();
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 } // namespace std
@@ -7,11 +7,13 @@
 #pragma once
 
 #include <iosfwd>
+#include <vector>
 
 #include "sdd/dd/definition.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/identity.hh"
+#include "sdd/mem/linear_alloc.hh"
 #include "sdd/order/order.hh"
 #include "sdd/util/packed.hh"
 
@@ -43,13 +45,22 @@ struct LIBSDD_ATTRIBUTE_PACKED _local
     operator()(const hierarchical_node<C>& node)
     const
     {
+      // Nested evaluations on arcs are independent, they can be evaluated in parallel.
+      std::vector<SDD<C>, mem::linear_alloc<SDD<C>>>
+        valuations(node.size(), mem::linear_alloc<SDD<C>>(cxt_.sdd_context().arena()));
+      cxt_.parallel_for(node.size(), [&](context<C>& local_cxt, std::size_t i)
+      {
+        valuations[i] = h_(local_cxt, order_.nested(), node.begin()[i].valuation());
+      });
+
       if (h_.selector()) // partition won't change
       {
         dd::square_union<C, SDD<C>> su(cxt_.sdd_context());
         su.reserve(node.size());
+        auto valuation_it = valuations.begin();
         for (const auto& arc : node)
         {
-          auto new_valuation = h_(cxt_, order_.nested(), arc.valuation());
+          auto& new_valuation = *valuation_it++;
           if (not new_valuation.empty())
           {
             su.add(arc.successor(), std::move(new_valuation));
@@ -61,10 +72,10 @@ struct LIBSDD_ATTRIBUTE_PACKED _local
       {
         dd::sum_builder<C, SDD<C>> sum_operands(cxt_.sdd_context());
         sum_operands.reserve(node.size());
+        auto valuation_it = valuations.begin();
         for (const auto& arc : node)
         {
-          auto new_valuation = h_(cxt_, order_.nested(), arc.valuation());
-          sum_operands.add(SDD<C>(node.variable(), std::move(new_valuation), arc.successor()));
+          sum_operands.add(SDD<C>(node.variable(), std::move(*valuation_it++), arc.successor()));
         }
         return dd::sum(cxt_.sdd_context(), std::move(sum_operands));
       }
@@ -0,0 +1,465 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // all_of, lower_bound
+#include <iosfwd>
+#include <map>
+#include <stdexcept> // invalid_argument
+#include <tuple>
+#include <utility>   // pair
+#include <vector>
+
+#include "sdd/dd/definition.hh"
+#include "sdd/hom/context_fwd.hh"
+#include "sdd/hom/definition_fwd.hh"
+#include "sdd/hom/identity.hh"
+#include "sdd/order/order.hh"
+#include "sdd/values/bitset.hh"
+#include "sdd/values/empty.hh"
+
+namespace sdd {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief The updates of a variable by a relation.
+///
+/// Each value which enables the relation is mapped to the values which replace it. A value which
+/// is not mapped disables the relation.
+template <typename C>
+using relation_updates = std::map<typename C::Values::value_type, typename C::Values>;
+
+namespace hom {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Call a function on each value of a set, in increasing order.
+template <typename Values, typename Function>
+void
+for_each_value(const Values& val, Function&& fun)
+{
+  for (const auto& v : val)
+  {
+    fun(v);
+  }
+}
+
+/// @internal
+/// @brief Call a function on each value of a bitset, which is not iterable.
+template <std::size_t Size, typename Function>
+void
+for_each_value(const values::bitset<Size>& val, Function&& fun)
+{
+  for (std::size_t i = 0; i < Size; ++i)
+  {
+    if (val.test(i))
+    {
+      fun(i);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Relation homomorphism.
+///
+/// It applies a relation which is the product of relations on single variables, like the
+/// transitions of a partitioned transition relation. Each instance handles one variable and
+/// delegates the following variables to next. Thus, all variables are updated in a single
+/// top-down traversal, without any intermediate SDD.
+template <typename C>
+struct _relation
+{
+  /// @brief The type of a set of values.
+  using values_type = typename C::Values;
+
+  /// @brief The type of a value.
+  using value_type = typename values_type::value_type;
+
+  /// @brief The type of the updates of a flat variable, sorted by values.
+  using table_type = std::vector<std::pair<value_type, values_type>>;
+
+  /// @brief The variable updated by this relation.
+  const typename C::variable_type variable;
+
+  /// @brief The updates of a flat variable, empty for a hierarchical one.
+  const table_type table;
+
+  /// @brief The relation to apply on the nested SDD of a hierarchical variable, Id otherwise.
+  const homomorphism<C> nested;
+
+  /// @brief The relation to apply on the following variables.
+  const homomorphism<C> next;
+
+  /// @brief Tell if the updates of this variable only select values.
+  const bool guard;
+
+  /// @brief Constructor.
+  _relation( typename C::variable_type var, table_type&& t, homomorphism<C> n
+           , homomorphism<C> nxt)
+    : variable(var), table(std::move(t)), nested(std::move(n)), next(std::move(nxt))
+    , guard(std::all_of( table.begin(), table.end()
+                       , [](const auto& u)
+                           {
+                             bool same = u.second.size() == 1;
+                             for_each_value( u.second
+                                           , [&](const value_type& v){same &= v == u.first;});
+                             return same;
+                           }))
+  {}
+
+  /// @brief Dispatch the Relation evaluation.
+  struct evaluation
+  {
+    /// @brief |0| case, should never happen.
+    SDD<C>
+    operator()(const zero_terminal<C>&, const _relation&, context<C>&, const order<C>&)
+    const noexcept
+    {
+      assert(false);
+      __builtin_unreachable();
+    }
+
+    /// @brief |1| case.
+    SDD<C>
+    operator()(const one_terminal<C>&, const _relation&, context<C>&, const order<C>&)
+    const
+    {
+      return one<C>();
+    }
+
+    /// @brief Evaluation on a flat node.
+    SDD<C>
+    operator()(const flat_node<C>& node, const _relation& r, context<C>& cxt, const order<C>& o)
+    const
+    {
+      return r.apply(node, cxt, o, [&](const values_type& val){return r.image(cxt, val);});
+    }
+
+    /// @brief Evaluation on a hierarchical node.
+    SDD<C>
+    operator()( const hierarchical_node<C>& node, const _relation& r, context<C>& cxt
+              , const order<C>& o)
+    const
+    {
+      return r.apply(node, cxt, o, [&](const SDD<C>& val){return r.nested(cxt, o.nested(), val);});
+    }
+  };
+
+  /// @brief Skip variable predicate.
+  bool
+  skip(const order<C>& o)
+  const noexcept
+  {
+    return variable != o.variable();
+  }
+
+  /// @brief Selector predicate.
+  bool
+  selector()
+  const noexcept
+  {
+    return guard and nested.selector() and next.selector();
+  }
+
+  /// @brief Evaluation.
+  SDD<C>
+  operator()(context<C>& cxt, const order<C>& o, const SDD<C>& x)
+  const
+  {
+    return visit(evaluation(), x, *this, cxt, o);
+  }
+
+  /// @brief Compute the values which replace a set of values.
+  values_type
+  image(context<C>& cxt, const values_type& val)
+  const
+  {
+    dd::sum_builder<C, values_type> builder(cxt.sdd_context());
+    // Values are iterated in increasing order, thus the search can start from the previous
+    // position.
+    auto search = table.begin();
+    for_each_value(val, [&](const value_type& v)
+    {
+      search = std::lower_bound( search, table.end(), v
+                               , [](const auto& u, const value_type& x){return u.first < x;});
+      if (search != table.end() and search->first == v)
+      {
+        builder.add(search->second);
+      }
+    });
+    return dd::sum(cxt.sdd_context(), std::move(builder));
+  }
+
+  friend
+  bool
+  operator==(const _relation& lhs, const _relation& rhs)
+  noexcept
+  {
+    return lhs.variable == rhs.variable and lhs.nested == rhs.nested and lhs.next == rhs.next
+       and lhs.table == rhs.table;
+  }
+
+  friend
+  std::ostream&
+  operator<<(std::ostream& os, const _relation& r)
+  {
+    os << "Rel(@" << r.variable << ", ";
+    if (r.nested != id<C>())
+    {
+      os << r.nested;
+    }
+    else
+    {
+      os << "[";
+      for (const auto& u : r.table)
+      {
+        os << " " << u.first << "->" << u.second;
+      }
+      os << " ]";
+    }
+    return os << ", " << r.next << ")";
+  }
+
+private:
+
+  /// @brief Apply this relation on the arcs of a node.
+  /// @param f Compute the image of a valuation.
+  template <typename Node, typename Image>
+  SDD<C>
+  apply(const Node& node, context<C>& cxt, const order<C>& o, Image&& f)
+  const
+  {
+    using valuation_type = typename Node::valuation_type;
+    if (selector())
+    {
+      // Valuations stay disjoint.
+      dd::square_union<C, valuation_type> su(cxt.sdd_context());
+      su.reserve(node.size());
+      for (const auto& arc : node)
+      {
+        valuation_type val = f(arc.valuation());
+        if (values::empty_values(val))
+        {
+          continue;
+        }
+        SDD<C> succ = next(cxt, o.next(), arc.successor());
+        if (not succ.empty())
+        {
+          su.add(std::move(succ), std::move(val));
+        }
+      }
+      return su.empty() ? zero<C>() : SDD<C>(variable, su());
+    }
+    else
+    {
+      dd::sum_builder<C, SDD<C>> sum_operands(cxt.sdd_context());
+      sum_operands.reserve(node.size());
+      for (const auto& arc : node)
+      {
+        valuation_type val = f(arc.valuation());
+        if (values::empty_values(val))
+        {
+          continue;
+        }
+        SDD<C> succ = next(cxt, o.next(), arc.successor());
+        if (not succ.empty())
+        {
+          sum_operands.add(SDD<C>(variable, std::move(val), std::move(succ)));
+        }
+      }
+      return dd::sum(cxt.sdd_context(), std::move(sum_operands));
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Create the relation on the variables of an order level and the following ones.
+/// @param targets The positions of the updated identifiers of o, with their updates.
+template <typename C>
+homomorphism<C>
+relation( const order<C>& o
+        , const std::vector<std::pair<order_position_type, const relation_updates<C>*>>& targets)
+{
+  using table_type = typename _relation<C>::table_type;
+
+  // The levels to update, from top to bottom.
+  std::vector<std::tuple<typename C::variable_type, table_type, homomorphism<C>>> levels;
+  for (auto current = o; not current.empty(); current = current.next())
+  {
+    if (current.nested().empty())
+    {
+      const auto search = std::find_if( targets.begin(), targets.end()
+                                      , [&](const auto& t){return t.first == current.position();});
+      if (search != targets.end())
+      {
+        table_type table;
+        for (const auto& u : *search->second)
+        {
+          if (not values::empty_values(u.second))
+          {
+            table.emplace_back(u.first, u.second);
+          }
+        }
+        levels.emplace_back(current.variable(), std::move(table), id<C>());
+      }
+    }
+    else
+    {
+      std::vector<std::pair<order_position_type, const relation_updates<C>*>> nested_targets;
+      for (const auto& t : targets)
+      {
+        if (t.first == current.position())
+        {
+          throw std::invalid_argument("Relation on a hierarchical identifier.");
+        }
+        if (o.contains(current.position(), t.first))
+        {
+          nested_targets.push_back(t);
+        }
+      }
+      if (not nested_targets.empty())
+      {
+        levels.emplace_back( current.variable(), table_type()
+                           , relation(current.nested(), nested_targets));
+      }
+    }
+  }
+
+  // Chain levels, starting from the bottom.
+  homomorphism<C> res = id<C>();
+  for (auto rcit = levels.rbegin(); rcit != levels.rend(); ++rcit)
+  {
+    res = hom::make<C, _relation<C>>( std::get<0>(*rcit), std::move(std::get<1>(*rcit))
+                                    , std::get<2>(*rcit), res);
+  }
+  return res;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Merge the relations on the same single flat variable.
+///
+/// The sum of two relations on the same single flat variable is the relation which maps each
+/// value to the union of its updates. Other homomorphisms are left untouched.
+template <typename C, typename Container>
+void
+cluster_relations(Container& homs)
+{
+  using table_type = typename _relation<C>::table_type;
+  using values_type = typename C::Values;
+
+  std::map<typename C::variable_type, std::map<typename values_type::value_type, values_type>>
+    clusters;
+  std::map<typename C::variable_type, std::size_t> nb_relations;
+  Container others;
+  for (const auto& h : homs)
+  {
+    if (mem::is<_relation<C>>(h))
+    {
+      const auto& r = mem::variant_cast<const _relation<C>>(*h);
+      if (r.next == id<C>() and r.nested == id<C>())
+      {
+        auto& cluster = clusters[r.variable];
+        nb_relations[r.variable] += 1;
+        for (const auto& u : r.table)
+        {
+          auto insertion = cluster.emplace(u.first, u.second);
+          if (not insertion.second)
+          {
+            insertion.first->second = sum(insertion.first->second, u.second);
+          }
+        }
+        continue;
+      }
+    }
+    others.push_back(h);
+  }
+
+  if (std::all_of( nb_relations.begin(), nb_relations.end()
+                 , [](const auto& n){return n.second == 1;}))
+  {
+    return;
+  }
+  for (auto& cluster : clusters)
+  {
+    table_type table(cluster.second.begin(), cluster.second.end());
+    others.push_back(hom::make<C, _relation<C>>( cluster.first, std::move(table), id<C>()
+                                               , id<C>()));
+  }
+  homs = std::move(others);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace hom
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Create the Relation homomorphism.
+/// @param o The order of the SDD on which the relation is applied.
+/// @param updates The updates of each identifier changed or read by the relation. Identifiers
+/// must be flat.
+/// @related homomorphism
+///
+/// A state is mapped to all the states where each updated identifier has one of the values of
+/// its update, and other identifiers are unchanged. A state is discarded if an updated identifier
+/// has a value which doesn't appear in its updates. A guard on an identifier is thus expressed
+/// by mapping each accepted value to itself.
+///
+/// It's equivalent to the composition of a Function for each identifier, but it's evaluated in a
+/// single traversal.
+template <typename C>
+homomorphism<C>
+relation( const order<C>& o
+        , const std::map<typename C::Identifier, relation_updates<C>>& updates)
+{
+  std::vector<std::pair<order_position_type, const relation_updates<C>*>> targets;
+  targets.reserve(updates.size());
+  for (const auto& u : updates)
+  {
+    targets.emplace_back(o.node(u.first).position(), &u.second);
+  }
+  return hom::relation(o, targets);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace sdd
+
+namespace std {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Hash specialization for sdd::hom::_relation.
+template <typename C>
+struct hash<sdd::hom::_relation<C>>
+{
+  std::size_t
+  operator()(const sdd::hom::_relation<C>& r)
+  const
+  {
+    using namespace sdd::hash;
+    std::size_t res = seed(r.variable) (val(r.nested)) (val(r.next));
+    for (const auto& u : r.table)
+    {
+      hash_combine(res, u.first);
+      hash_combine(res, u.second);
+    }
+    return res;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace std
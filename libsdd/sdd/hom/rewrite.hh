@@ -12,9 +12,12 @@
 
 #include "sdd/hom/common_types.hh"
 #include "sdd/hom/context_fwd.hh"
+#include "sdd/hom/composition.hh"
 #include "sdd/hom/definition_fwd.hh"
 #include "sdd/hom/fixpoint.hh"
+#include "sdd/hom/if_then_else.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/hom/relation.hh"
 #include "sdd/hom/saturation_fixpoint.hh"
 #include "sdd/hom/saturation_intersection.hh"
 #include "sdd/hom/saturation_sum.hh"
@@ -69,6 +72,11 @@ struct rewriter
         const _local<C>& l = mem::variant_cast<const _local<C>>(**begin);
         L.push_back(l.h);
       }
+      else if (local_relation(*begin))
+      {
+        // A relation on a single hierarchical variable is a Local.
+        L.push_back(mem::variant_cast<const _relation<C>>(**begin).nested);
+      }
       else
       {
         G.push_back(*begin);
@@ -77,6 +85,50 @@ struct rewriter
     return std::make_tuple(std::move(F), std::move(G), std::move(L), has_id);
   }
 
+  /// @brief Get the operands of a chain of compositions, from the last applied to the first.
+  static
+  void
+  flatten(const homomorphism<C>& h, hom_list_type& operands)
+  {
+    if (mem::is<_composition<C>>(h))
+    {
+      const _composition<C>& c = mem::variant_cast<const _composition<C>>(*h);
+      flatten(c.left, operands);
+      flatten(c.right, operands);
+    }
+    else if (h != id<C>())
+    {
+      operands.push_back(h);
+    }
+  }
+
+  /// @brief Compose homomorphisms, from the last applied to the first.
+  static
+  homomorphism<C>
+  compose(const hom_list_type& operands)
+  {
+    auto res = id<C>();
+    for (auto rcit = operands.rbegin(); rcit != operands.rend(); ++rcit)
+    {
+      res = composition(*rcit, res);
+    }
+    return res;
+  }
+
+  /// @brief Tell if a relation only updates the nested SDD of its variable.
+  static
+  bool
+  local_relation(const homomorphism<C>& h)
+  noexcept
+  {
+    if (not mem::is<_relation<C>>(h))
+    {
+      return false;
+    }
+    const auto& r = mem::variant_cast<const _relation<C>>(*h);
+    return r.next == id<C>() and r.nested != id<C>();
+  }
+
   /// @brief Rewrite sum into a Saturation sum, if possible.
   homomorphism<C>
   operator()(const _sum<C>& s, const homomorphism<C>& h, const order<C>& o)
@@ -98,6 +150,9 @@ struct rewriter
       F.push_back(id<C>());
     }
 
+    // Relations on the same variable are applied in a single traversal.
+    cluster_relations<C>(G);
+
     return saturation_sum( o.variable()
                          , F.size() > 0 ? rewrite(o.next(), sum(o.next(), F.begin(), F.end()))
                                         : optional_homomorphism<C>()
@@ -144,6 +199,99 @@ struct rewriter
                            );
   }
 
+  /// @brief Rewrite a Composition to saturate its operands.
+  ///
+  /// Operands which skip the current variable commute with Local on this variable. Thus, between
+  /// two operands which work on the current variable, all Local are merged in a single one and
+  /// the other operands are composed and rewritten on the next variable. A composition which skips
+  /// the current variable is then directly rewritten on the next one.
+  homomorphism<C>
+  operator()(const _composition<C>&, const homomorphism<C>& h, const order<C>& o)
+  const
+  {
+    hom_list_type operands;
+    flatten(h, operands);
+
+    hom_list_type res;
+    hom_list_type F;
+    hom_list_type L;
+    const auto flush = [&]
+    {
+      if (not L.empty())
+      {
+        res.push_back(local(o.variable(), rewrite(o.nested(), compose(L))));
+        L.clear();
+      }
+      if (not F.empty())
+      {
+        res.push_back(rewrite(o.next(), compose(F)));
+        F.clear();
+      }
+    };
+
+    for (const auto& operand : operands)
+    {
+      if (operand.skip(o))
+      {
+        F.push_back(operand);
+      }
+      else if (mem::is<_local<C>>(operand))
+      {
+        L.push_back(mem::variant_cast<const _local<C>>(*operand).h);
+      }
+      else if (local_relation(operand))
+      {
+        L.push_back(mem::variant_cast<const _relation<C>>(*operand).nested);
+      }
+      else
+      {
+        flush();
+        res.push_back(rewrite(o, operand));
+      }
+    }
+    flush();
+
+    return compose(res);
+  }
+
+  /// @brief Rewrite an If Then Else to saturate its operands.
+  ///
+  /// The operations applied last by both branches are factored out of it, as
+  /// ite(p, a o b, a o c) == a o ite(p, b, c). When the predicate only works on deeper variables,
+  /// it then often skips the current variable, thus it's rewritten on the next one.
+  homomorphism<C>
+  operator()(const _if_then_else<C>& ite, const homomorphism<C>& h, const order<C>& o)
+  const
+  {
+    hom_list_type then_operands;
+    hom_list_type else_operands;
+    flatten(ite.h_then, then_operands);
+    flatten(ite.h_else, else_operands);
+
+    hom_list_type common;
+    while (not then_operands.empty() and not else_operands.empty()
+           and then_operands.front() == else_operands.front())
+    {
+      common.push_back(then_operands.front());
+      then_operands.pop_front();
+      else_operands.pop_front();
+    }
+
+    if (not common.empty())
+    {
+      common.push_back(if_then_else(ite.h_if, compose(then_operands), compose(else_operands)));
+      return rewrite(o, compose(common));
+    }
+    else if (h.skip(o))
+    {
+      return rewrite(o.next(), h);
+    }
+    else
+    {
+      return if_then_else(rewrite(o, ite.h_if), rewrite(o, ite.h_then), rewrite(o, ite.h_else));
+    }
+  }
+
   /// @brief Rewrite a Fixpoint into a Saturation Fixpoint, if possible.
   homomorphism<C>
   operator()(const _fixpoint<C>& f, const homomorphism<C>& h, const order<C>& o)
@@ -151,7 +299,8 @@ struct rewriter
   {
     if (not mem::is<_sum<C>>(f.h))
     {
-      return h;
+      // The iterated homomorphism can still be saturated.
+      return fixpoint(rewrite(o, f.h));
     }
 
     const _sum<C>& s = mem::variant_cast<const _sum<C>>(*f.h);
@@ -184,6 +333,9 @@ struct rewriter
         = local(o.variable(), rewrite(o.nested(), fixpoint(sum(o.nested(), L.begin(), L.end()))));
     }
 
+    // Relations on the same variable are applied in a single traversal.
+    cluster_relations<C>(G);
+
     // Put selectors in front. It might help cut paths sooner in the Saturation Fixpoint's
     // evaluation.
     std::partition(G.begin(), G.end(), [](const homomorphism<C>& g){return g.selector();});
@@ -9,6 +9,7 @@
 #include <algorithm>  // all_of, copy, equal
 #include <iosfwd>
 #include <stdexcept>  // invalid_argument
+#include <vector>
 
 #include <boost/container/flat_set.hpp>
 
@@ -17,8 +18,11 @@
 #include "sdd/hom/consolidate.hh"
 #include "sdd/hom/context_fwd.hh"
 #include "sdd/hom/definition_fwd.hh"
+#include "sdd/hom/fixpoint.hh"
+#include "sdd/hom/fixpoint_strategy.hh"
 #include "sdd/hom/identity.hh"
 #include "sdd/hom/local.hh"
+#include "sdd/mem/linear_alloc.hh"
 #include "sdd/order/order.hh"
 #include "sdd/util/packed.hh"
 
@@ -81,7 +85,27 @@ public:
   operator()(context<C>& cxt, const order<C>& o, const SDD<C>& s)
   const
   {
+    if (cxt.fixpoint_strategy() != fixpoint_strategy::accumulate)
+    {
+      // (F + Id)* and (L + Id)* are applied to new states until they no longer change, as they
+      // might enable each other. Then only G is applied to the frontier.
+      return reachable( cxt, o, s, begin(), end()
+                      , [&](const SDD<C>& states, std::size_t& applications)
+                          {
+                            SDD<C> s1 = states;
+                            SDD<C> s2 = states;
+                            do
+                            {
+                              s1 = s2;
+                              s2 = L(cxt, o, F(cxt, o, s2));
+                              applications += 2;
+                            } while (s1 != s2);
+                            return s1;
+                          });
+    }
+
     auto& sdd_context = cxt.sdd_context();
+    fixpoint_iterations iterations(cxt.fixpoint_stats());
 
     SDD<C> s1 = s;
     SDD<C> s2 = s;
@@ -93,11 +117,34 @@ public:
       s2 = F(cxt, o, s2); // apply (F + Id)*
       s2 = L(cxt, o, s2); // apply (L + Id)*
 
-      for (const auto& g : *this)
+      if (G_size > 1 and sdd_context.parallel())
+      {
+        // apply all G on the same SDD concurrently, then merge their results
+        std::vector<SDD<C>, mem::linear_alloc<SDD<C>>>
+          results(G_size, mem::linear_alloc<SDD<C>>(sdd_context.arena()));
+        cxt.parallel_for(G_size, 2, [&](context<C>& local_cxt, std::size_t i)
+        {
+          results[i] = begin()[i](local_cxt, o, s2);
+        });
+
+        dd::sum_builder<C, SDD<C>> operands(sdd_context);
+        operands.reserve(G_size + 1);
+        operands.add(s2);
+        for (auto& result : results)
+        {
+          operands.add(std::move(result));
+        }
+        s2 = dd::sum(sdd_context, std::move(operands));
+      }
+      else
       {
-        // chain applications of G
-        s2 = dd::sum(sdd_context, dd::sum_builder<C, SDD<C>>(sdd_context, {s2, g(cxt, o, s2)}));
+        for (const auto& g : *this)
+        {
+          // chain applications of G
+          s2 = dd::sum(sdd_context, dd::sum_builder<C, SDD<C>>(sdd_context, {s2, g(cxt, o, s2)}));
+        }
       }
+      iterations.next(G_size + 2);
     } while (s1 != s2);
 
     return s1;
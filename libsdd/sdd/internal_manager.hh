@@ -16,6 +16,7 @@
 #include "sdd/hom/context.hh"
 #include "sdd/hom/definition.hh"
 #include "sdd/hom/identity.hh"
+#include "sdd/mem/sharded_unique_table.hh"
 #include "sdd/mem/unique_table.hh"
 
 namespace sdd {
@@ -47,31 +48,36 @@ struct internal_manager
   /// @brief The type of a smart pointer to a unified homomorphism.
   using hom_ptr_type = typename homomorphism<C>::ptr_type;
 
+  /// @brief The type of the table of unified SDD.
+  using sdd_unique_table_type = typename C::template unique_table_type<sdd_unique_type>;
+
+  /// @brief The type of the table of unified homomorphisms.
+  using hom_unique_table_type = typename C::template unique_table_type<hom_unique_type>;
+
   /// @brief Manage the handlers needed by ptr when a unified data is no longer referenced.
   struct ptr_handlers
   {
-    ptr_handlers( mem::unique_table<sdd_unique_type>& sdd_ut
-                , mem::unique_table<hom_unique_type>& hom_ut)
+    ptr_handlers(sdd_unique_table_type& sdd_ut, hom_unique_table_type& hom_ut)
     {
-      mem::set_deletion_handler<sdd_unique_type>([&](const sdd_unique_type* u){sdd_ut.erase(u);});
-      mem::set_deletion_handler<hom_unique_type>([&](const hom_unique_type* u){hom_ut.erase(u);});
+      mem::set_deletion_table(sdd_ut);
+      mem::set_deletion_table(hom_ut);
     }
 
     ~ptr_handlers()
     {
-      mem::reset_deletion_handler<sdd_unique_type>();
-      mem::reset_deletion_handler<hom_unique_type>();
+      mem::reset_deletion_table<sdd_unique_table_type>();
+      mem::reset_deletion_table<hom_unique_table_type>();
     }
   } handlers;
 
   /// @brief The set of a unified SDD.
-  mem::unique_table<sdd_unique_type> sdd_unique_table;
+  sdd_unique_table_type sdd_unique_table;
 
   /// @brief The SDD operations evaluation context.
   dd::context<C> sdd_context;
 
   /// @brief The set of unified homomorphisms.
-  mem::unique_table<hom_unique_type> hom_unique_table;
+  hom_unique_table_type hom_unique_table;
 
   /// @brief The homomorphisms evaluation context.
   hom::context<C> hom_context;
@@ -91,18 +97,25 @@ struct internal_manager
   /// @brief Constructor with a given configuration.
   internal_manager(const C& configuration)
     : handlers(sdd_unique_table, hom_unique_table)
-    , sdd_unique_table(configuration.sdd_unique_table_size)
+    , sdd_unique_table(configuration.sdd_unique_table_size, configuration.sdd_collection_threshold)
     , sdd_context( configuration.sdd_difference_cache_size
+                 , configuration.sdd_difference_sum_cache_size
                  , configuration.sdd_intersection_cache_size
                  , configuration.sdd_sum_cache_size
-                 , configuration.sdd_arena_size)
+                 , configuration.sdd_arena_size
+                 , configuration.sdd_nb_threads
+                 , configuration.sdd_parallel_threshold)
     , hom_unique_table(configuration.hom_unique_table_size)
-    , hom_context(configuration.hom_cache_size, sdd_context)
+    , hom_context( configuration.hom_cache_size, sdd_context
+                 , configuration.hom_fixpoint_strategy, configuration.hom_function_cache_size)
     , zero(mk_terminal<zero_terminal<C>>())
     , one(mk_terminal<one_terminal<C>>())
     , id(mk_id())
     , saturation_fixpoint_data()
-  {}
+  {
+    assert( (configuration.sdd_nb_threads <= 1 or C::thread_safe)
+          && "Parallel evaluation requires a thread-safe configuration");
+  }
 
 private:
 
@@ -113,7 +126,7 @@ private:
   {
     char* addr = sdd_unique_table.allocate(0 /*extra bytes*/);
     sdd_unique_type* u = new (addr) sdd_unique_type(mem::construct<T>());
-    return sdd_ptr_type(&sdd_unique_table(u, 0));
+    return mem::make_ptr(sdd_unique_table, u, 0);
   }
 
   /// @brief Helper to construct Id.
@@ -122,7 +135,7 @@ private:
   {
     char* addr = hom_unique_table.allocate(0 /*extra bytes*/);
     hom_unique_type* u = new (addr) hom_unique_type(mem::construct<hom::_identity<C>>());
-    return hom_ptr_type(&hom_unique_table(u, 0));
+    return mem::make_ptr(hom_unique_table, u, 0);
   }
 };
 
@@ -82,6 +82,16 @@ public:
     ptr_->reset_hom_cache();
   }
 
+  /// @brief Destroy all SDD which are no longer referenced.
+  /// @return The number of destroyed SDD.
+  ///
+  /// Only useful when the configuration defers the collection of SDD (sdd_collection_threshold).
+  std::size_t
+  collect()
+  {
+    return ptr_->collect();
+  }
+
   /// @internal
   /// @brief Get the statistics for SDDs.
   const mem::unique_table_statistics&
@@ -100,6 +110,15 @@ public:
     return ptr_->sdd_difference_cache_stats();
   }
 
+  /// @internal
+  /// @brief Get the statistics for SDD fused (lhs - rhs) + addend operations.
+  const mem::cache_statistics&
+  sdd_difference_sum_cache_stats()
+  const noexcept
+  {
+    return ptr_->sdd_difference_sum_cache_stats();
+  }
+
   /// @internal
   /// @brief Get the statistics for SDD intersection operations.
   const mem::cache_statistics&
@@ -136,6 +155,21 @@ public:
     return ptr_->hom_cache_stats();
   }
 
+  /// @brief Get the statistics of Fixpoint and Saturation Fixpoint evaluations.
+  fixpoint_statistics
+  hom_fixpoint_stats()
+  const
+  {
+    return ptr_->hom_fixpoint_stats();
+  }
+
+  /// @brief Reset the statistics of Fixpoint and Saturation Fixpoint evaluations.
+  void
+  reset_hom_fixpoint_stats()
+  {
+    ptr_->reset_hom_fixpoint_stats();
+  }
+
   /// @internal
   auto
   values_stats()
@@ -193,6 +227,13 @@ public:
     m_->hom_context.clear();
   }
 
+  /// @brief Destroy all SDD which are no longer referenced.
+  std::size_t
+  collect()
+  {
+    return m_->sdd_unique_table.collect();
+  }
+
   /// @internal
   /// @brief Get the statistics for SDDs.
   const mem::unique_table_statistics&
@@ -211,6 +252,15 @@ public:
     return m_->sdd_context.difference_cache().statistics();
   }
 
+  /// @internal
+  /// @brief Get the statistics for SDD fused (lhs - rhs) + addend operations.
+  const mem::cache_statistics&
+  sdd_difference_sum_cache_stats()
+  const noexcept
+  {
+    return m_->sdd_context.difference_sum_cache().statistics();
+  }
+
   /// @internal
   /// @brief Get the statistics for SDD intersection operations.
   const mem::cache_statistics&
@@ -247,6 +297,21 @@ public:
     return m_->hom_context.cache().statistics();
   }
 
+  /// @brief Get the statistics of Fixpoint and Saturation Fixpoint evaluations.
+  fixpoint_statistics
+  hom_fixpoint_stats()
+  const
+  {
+    return m_->hom_context.fixpoint_stats().statistics();
+  }
+
+  /// @brief Reset the statistics of Fixpoint and Saturation Fixpoint evaluations.
+  void
+  reset_hom_fixpoint_stats()
+  {
+    m_->hom_context.fixpoint_stats().clear();
+  }
+
   /// @internal
   auto
   values_stats()
@@ -6,12 +6,13 @@
 
 #pragma once
 
-#include <memory> // unique_ptr
+#include <functional> // hash
+#include <memory>     // unique_ptr
 #include <tuple>
 
 #include "sdd/mem/cache_entry.hh"
+#include "sdd/mem/cache_eviction.hh"
 #include "sdd/mem/hash_table.hh"
-#include "sdd/mem/lru_list.hh"
 #include "sdd/util/hash.hh"
 
 namespace sdd { namespace mem {
@@ -74,7 +75,7 @@ struct cache_statistics
   /// @brief The number of filtered entries.
   std::size_t filtered;
 
-  /// @brief The number of entries discarded by the LRU policy.
+  /// @brief The number of entries discarded by the eviction policy.
   std::size_t discarded;
 
   /// @brief The number of buckets with more than one element in the underlying hash table.
@@ -98,15 +99,15 @@ struct cache_statistics
 /// @internal
 /// @brief  A generic cache.
 /// @tparam Operation is the operation type.
+/// @tparam EvictionPolicy decides which entry to remove when the cache is full (lru_eviction or
+/// clock_eviction).
 /// @tparam Filters is a list of filters that reject some operations.
-///
-/// It uses the LRU strategy to cleanup old entries.
-template <typename Context, typename Operation, typename... Filters>
-class cache
+template <typename Context, typename Operation, typename EvictionPolicy, typename... Filters>
+class basic_cache
 {
-  // Can't copy a cache.
-  cache(const cache&) = delete;
-  cache* operator=(const cache&) = delete;
+  // Can't copy a basic_cache.
+  basic_cache(const basic_cache&) = delete;
+  basic_cache* operator=(const basic_cache&) = delete;
 
 private:
 
@@ -117,7 +118,7 @@ private:
   using result_type = std::result_of_t<Operation(context_type&)>;
 
   /// @brief The of an entry that stores an operation and its result.
-  using cache_entry_type = cache_entry<Operation, result_type>;
+  using cache_entry_type = cache_entry<Operation, result_type, EvictionPolicy>;
 
   /// @brief An intrusive hash table.
   using set_type = mem::hash_table<cache_entry_type, false /* no rehash */>;
@@ -131,12 +132,12 @@ private:
   /// @brief The actual storage of caches entries.
   set_type set_;
 
-  /// @brief The the container that sorts cache entries by last access date.
-  lru_list<cache_entry_type> lru_list_;
-
   /// @brief The maximum size this cache is authorized to grow to.
   std::size_t max_size_;
 
+  /// @brief Decide which entry to remove when the cache is full.
+  typename EvictionPolicy::template queue<cache_entry_type> eviction_;
+
   /// @brief The statistics of this cache.
   mutable cache_statistics stats_;
 
@@ -189,70 +190,78 @@ public:
   /// @param context This cache's context.
   /// @param size How many cache entries are kept, should be greater than the order height.
   ///
-  /// When the maximal size is reached, a cleanup is launched: half of the cache is removed,
-  /// using a LRU strategy. This cache will never perform a rehash, therefore it allocates
-  /// all the memory it needs at its construction.
-  cache(context_type& context, std::size_t size)
+  /// When the maximal size is reached, an entry is removed for each new one, as chosen by the
+  /// eviction policy. This cache will never perform a rehash, therefore it allocates all the
+  /// memory it needs at its construction.
+  basic_cache(context_type& context, std::size_t size)
     : cxt_(context)
     , set_(size, max_load_factor)
-    , lru_list_()
     , max_size_(set_.bucket_count() * max_load_factor)
+    , eviction_(max_size_)
     , stats_()
     , pool_(max_size_)
   {}
 
   /// @brief Destructor.
-  ~cache()
+  ~basic_cache()
   {
     clear();
   }
 
-  /// @brief Cache lookup.
+  /// @brief Cache lookup, evaluation in this cache's context.
   result_type
   operator()(Operation&& op)
+  {
+    return (*this)(cxt_, std::move(op));
+  }
+
+  /// @brief Cache lookup, evaluation in a given context.
+  result_type
+  operator()(context_type& cxt, Operation&& op)
   {
     // Check if the current operation should be cached or not.
     if (not apply_filters<Operation, Filters...>()(op))
     {
       ++stats_.filtered;
-      return op(cxt_);
+      return op(cxt);
     }
 
     // Lookup for op.
     typename set_type::insert_commit_data commit_data;
-    auto insertion = set_.insert_check( op
-                                      , [](auto&& lhs, auto&& rhs){return lhs == rhs.operation;}
+    const std::size_t hash = std::hash<Operation>()(op);
+    auto insertion = set_.insert_check( op, hash
+                                      , [hash](auto&& lhs, auto&& rhs)
+                                          {
+                                            return hash == rhs.hash and lhs == rhs.operation;
+                                          }
                                       , commit_data);
 
     // Check if op has already been computed.
     if (not insertion.second)
     {
       ++stats_.hits;
-      // Move cache entry to the end of the LRU list.
-      lru_list_.splice(lru_list_.end(), lru_list_, insertion.first->lru_cit_);
+      eviction_.touch(*insertion.first);
       return insertion.first->result;
     }
 
     ++stats_.misses;
 
     cache_entry_type* entry;
-    auto res = op(cxt_); // evaluation may throw
+    auto res = op(cxt); // evaluation may throw
 
     // Clean up the cache, if necessary.
     if (set_.size() == max_size_)
     {
-      auto oldest = lru_list_.front();
-      set_.erase(oldest);
-      oldest->~cache_entry_type();
-      pool_.deallocate(oldest);
-      lru_list_.pop_front();
+      auto& victim = eviction_.victim();
+      set_.erase(&victim);
+      eviction_.erase(victim);
+      victim.~cache_entry_type();
+      pool_.deallocate(&victim);
       ++stats_.discarded;
     }
 
-    entry = new (pool_.allocate()) cache_entry_type(std::move(op), std::move(res));
-
-    // Add the new cache entry to the end of the LRU list.
-    entry->lru_cit_ = lru_list_.insert(lru_list_.end(), entry);
+    entry = new (pool_.allocate()) cache_entry_type(std::move(op), hash, std::move(res));
+    eviction_.insert(*entry);
 
     // Finally, set the result associated to op.
     set_.insert_commit(entry, commit_data); // doesn't throw
@@ -270,6 +279,7 @@ public:
                                 x->~cache_entry_type();
                                 pool_.deallocate(x);
                               });
+    eviction_.clear();
   }
 
   /// @brief Get the number of cached operations.
@@ -295,4 +305,11 @@ public:
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief A generic cache which evicts the least recently used entries.
+template <typename Context, typename Operation, typename... Filters>
+using cache = basic_cache<Context, Operation, lru_eviction, Filters...>;
+
+/*------------------------------------------------------------------------------------------------*/
+
 }} // namespace sdd::mem
@@ -7,12 +7,9 @@
 #pragma once
 
 #include <functional> // hash
-#include <list>
 #include <utility>    // forward
 
 #include "sdd/mem/hash_table.hh"
-#include "sdd/mem/lru_list.hh"
-#include "sdd/util/hash.hh"
 
 namespace sdd { namespace mem {
 
@@ -22,7 +19,8 @@ namespace sdd { namespace mem {
 /// @brief Associate an operation to its result into the cache.
 ///
 /// The operation acts as a key and the associated result is the value counterpart.
-template <typename Operation, typename Result>
+/// @tparam EvictionPolicy The policy which decides which entry to remove from a full cache.
+template <typename Operation, typename Result, typename EvictionPolicy>
 struct cache_entry
 {
   // Can't copy a cache_entry.
@@ -32,22 +30,27 @@ struct cache_entry
   /// @brief
   mem::intrusive_member_hook<cache_entry> hook;
 
+  /// @brief The hash value of operation, computed once when the entry is looked for.
+  const std::size_t hash;
+
   /// @brief The cached operation.
   const Operation operation;
 
   /// @brief The result of the evaluation of operation.
   const Result result;
 
-  /// @brief Where this cache entry is stored in the LRU list.
-  typename lru_list<cache_entry>::const_iterator lru_cit_;
+  /// @brief The data needed by the eviction policy.
+  typename EvictionPolicy::template hook<cache_entry> eviction_hook;
 
   /// @brief Constructor.
+  /// @param h The hash value of op.
   template <typename... Args>
-  cache_entry(Operation&& op, Args&&... args)
+  cache_entry(Operation&& op, std::size_t h, Args&&... args)
     : hook()
+    , hash(h)
     , operation(std::move(op))
     , result(std::forward<Args>(args)...)
-    , lru_cit_()
+    , eviction_hook()
   {}
 
   /// @brief Cache entries are only compared using their operations.
@@ -56,7 +59,7 @@ struct cache_entry
   operator==(const cache_entry& lhs, const cache_entry& rhs)
   noexcept
   {
-    return lhs.operation == rhs.operation;
+    return lhs.hash == rhs.hash and lhs.operation == rhs.operation;
   }
 };
 
@@ -69,16 +72,16 @@ namespace std {
 /*------------------------------------------------------------------------------------------------*/
 
 /// @internal
-template <typename Operation, typename Result>
-struct hash<sdd::mem::cache_entry<Operation, Result>>
+template <typename Operation, typename Result, typename EvictionPolicy>
+struct hash<sdd::mem::cache_entry<Operation, Result, EvictionPolicy>>
 {
   std::size_t
-  operator()(const sdd::mem::cache_entry<Operation, Result>& x)
+  operator()(const sdd::mem::cache_entry<Operation, Result, EvictionPolicy>& x)
+  const noexcept
   {
-    using namespace sdd::hash;
     // A cache entry must have the same hash as its contained operation. Otherwise, cache::erase()
     // and cache::insert_check()/cache::insert_commit() won't use the same position in buckets.
-    return seed(x.operation);
+    return x.hash;
   }
 };
 
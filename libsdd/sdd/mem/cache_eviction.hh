@@ -0,0 +1,241 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // fill
+#include <cassert>
+#include <memory>    // unique_ptr
+
+namespace sdd { namespace mem {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Evict the least recently used cache entry.
+///
+/// Entries are sorted by last access date in a doubly linked list whose links are stored in the
+/// entries themselves. Thus, neither a hit nor a miss allocates memory.
+struct lru_eviction
+{
+  /// @brief The data stored in each cache entry.
+  template <typename Entry>
+  struct hook
+  {
+    /// @brief The previous entry, accessed less recently.
+    Entry* prev = nullptr;
+
+    /// @brief The next entry, accessed more recently.
+    Entry* next = nullptr;
+  };
+
+  /// @brief Sort all entries of a cache.
+  template <typename Entry>
+  class queue
+  {
+  private:
+
+    /// @brief The least recently used entry.
+    Entry* oldest_;
+
+    /// @brief The most recently used entry.
+    Entry* newest_;
+
+  public:
+
+    /// @brief Constructor.
+    queue(std::size_t /*capacity*/)
+      : oldest_(nullptr), newest_(nullptr)
+    {}
+
+    /// @brief Add a new entry.
+    void
+    insert(Entry& e)
+    noexcept
+    {
+      e.eviction_hook.prev = newest_;
+      e.eviction_hook.next = nullptr;
+      if (newest_ != nullptr)
+      {
+        newest_->eviction_hook.next = &e;
+      }
+      else
+      {
+        oldest_ = &e;
+      }
+      newest_ = &e;
+    }
+
+    /// @brief Tell that an entry has been accessed.
+    void
+    touch(Entry& e)
+    noexcept
+    {
+      if (&e != newest_)
+      {
+        erase(e);
+        insert(e);
+      }
+    }
+
+    /// @brief Get the entry to evict.
+    Entry&
+    victim()
+    noexcept
+    {
+      assert(oldest_ != nullptr);
+      return *oldest_;
+    }
+
+    /// @brief Remove an entry.
+    void
+    erase(Entry& e)
+    noexcept
+    {
+      auto& h = e.eviction_hook;
+      (h.prev != nullptr ? h.prev->eviction_hook.next : oldest_) = h.next;
+      (h.next != nullptr ? h.next->eviction_hook.prev : newest_) = h.prev;
+    }
+
+    /// @brief Remove all entries.
+    void
+    clear()
+    noexcept
+    {
+      oldest_ = nullptr;
+      newest_ = nullptr;
+    }
+  };
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Evict cache entries with the CLOCK (second chance) strategy.
+///
+/// Entries are stored in a circular array of slots, allocated once. A hit only sets the
+/// 'referenced' bit of the entry. To find an entry to evict, a hand sweeps the slots: it clears
+/// the bit of referenced entries and stops on the first one which was not referenced. It's
+/// cheaper than a LRU on a hit, at the price of a less precise eviction.
+struct clock_eviction
+{
+  /// @brief The data stored in each cache entry.
+  template <typename Entry>
+  struct hook
+  {
+    /// @brief The slot of the entry.
+    std::size_t slot = 0;
+
+    /// @brief Tell if the entry has been accessed since the last sweep of the hand.
+    bool referenced = false;
+  };
+
+  /// @brief Store all entries of a cache.
+  template <typename Entry>
+  class queue
+  {
+  private:
+
+    /// @brief The slots; an empty slot is nullptr.
+    std::unique_ptr<Entry*[]> slots_;
+
+    /// @brief The number of slots.
+    const std::size_t capacity_;
+
+    /// @brief The current slot.
+    std::size_t hand_;
+
+  public:
+
+    /// @brief Constructor.
+    /// @param capacity The maximal number of entries, must be greater than 0.
+    queue(std::size_t capacity)
+      : slots_(std::make_unique<Entry*[]>(capacity)), capacity_(capacity), hand_(0)
+    {
+      assert(capacity_ != 0);
+    }
+
+    /// @brief Add a new entry.
+    ///
+    /// There must be an empty slot.
+    void
+    insert(Entry& e)
+    noexcept
+    {
+      // The slot of the last victim, if any, is the current one.
+      while (slots_[hand_] != nullptr)
+      {
+        advance();
+      }
+      slots_[hand_] = &e;
+      e.eviction_hook.slot = hand_;
+      e.eviction_hook.referenced = false;
+      advance();
+    }
+
+    /// @brief Tell that an entry has been accessed.
+    void
+    touch(Entry& e)
+    noexcept
+    {
+      e.eviction_hook.referenced = true;
+    }
+
+    /// @brief Get the entry to evict.
+    ///
+    /// There must be at least one entry.
+    Entry&
+    victim()
+    noexcept
+    {
+      while (true)
+      {
+        Entry* e = slots_[hand_];
+        if (e != nullptr)
+        {
+          if (not e->eviction_hook.referenced)
+          {
+            return *e;
+          }
+          e->eviction_hook.referenced = false;
+        }
+        advance();
+      }
+    }
+
+    /// @brief Remove an entry.
+    void
+    erase(Entry& e)
+    noexcept
+    {
+      assert(slots_[e.eviction_hook.slot] == &e);
+      slots_[e.eviction_hook.slot] = nullptr;
+    }
+
+    /// @brief Remove all entries.
+    void
+    clear()
+    noexcept
+    {
+      std::fill(slots_.get(), slots_.get() + capacity_, nullptr);
+      hand_ = 0;
+    }
+
+  private:
+
+    /// @brief Move the hand to the next slot.
+    void
+    advance()
+    noexcept
+    {
+      hand_ = hand_ + 1 == capacity_ ? 0 : hand_ + 1;
+    }
+  };
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::mem
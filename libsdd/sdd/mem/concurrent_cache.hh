@@ -0,0 +1,269 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <atomic>
+#include <functional>  // hash
+#include <memory>      // unique_ptr
+#include <type_traits> // aligned_storage
+
+#include "sdd/mem/cache.hh"
+#include "sdd/util/next_power.hh"
+
+namespace sdd { namespace mem {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief  A cache which can be probed and filled by several threads at once.
+/// @tparam Operation is the operation type.
+/// @tparam Filters is a list of filters that reject some operations.
+///
+/// It's a lossy direct-mapped cache: an operation can only be stored in the slot given by its
+/// hash value, a new entry simply replaces the previous one. Each slot is guarded by a flag which
+/// is only ever tried, never waited for: a slot already used by another thread is considered as
+/// a miss and the result of the operation is then not stored. Thus, a thread never blocks on this
+/// cache, at the price of a few lost entries.
+template <typename Context, typename Operation, typename... Filters>
+class concurrent_cache
+{
+  // Can't copy a concurrent_cache.
+  concurrent_cache(const concurrent_cache&) = delete;
+  concurrent_cache* operator=(const concurrent_cache&) = delete;
+
+private:
+
+  /// @brief The type of the context of this cache.
+  using context_type = Context;
+
+  /// @brief The type of the result of an operation stored in the cache.
+  using result_type = std::result_of_t<Operation(context_type&)>;
+
+  /// @brief An operation and its result.
+  struct entry
+  {
+    /// @brief The cached operation.
+    const Operation operation;
+
+    /// @brief The result of the evaluation of operation.
+    const result_type result;
+  };
+
+  /// @brief A storage place for one entry.
+  struct slot
+  {
+    /// @brief Tell if a thread is accessing this slot.
+    std::atomic<bool> busy;
+
+    /// @brief Tell if storage contains an entry.
+    bool full;
+
+    /// @brief The hash value of the stored operation, checked before the operation itself.
+    std::size_t hash;
+
+    /// @brief Where the entry is constructed.
+    std::aligned_storage_t<sizeof(entry), alignof(entry)> storage;
+
+    slot()
+      : busy(false), full(false), hash(0), storage()
+    {}
+
+    entry&
+    get()
+    noexcept
+    {
+      return *reinterpret_cast<entry*>(&storage);
+    }
+
+    bool
+    try_lock()
+    noexcept
+    {
+      return not busy.exchange(true, std::memory_order_acquire);
+    }
+
+    void
+    unlock()
+    noexcept
+    {
+      busy.store(false, std::memory_order_release);
+    }
+  };
+
+  /// @brief This cache's default context.
+  context_type& cxt_;
+
+  /// @brief The number of slots, a power of 2.
+  const std::size_t nb_slots_;
+
+  /// @brief The actual storage of cache entries.
+  std::unique_ptr<slot[]> slots_;
+
+  /// @brief The number of stored entries.
+  std::atomic<std::size_t> size_;
+
+  /// @brief The number of hits.
+  std::atomic<std::size_t> hits_;
+
+  /// @brief The number of misses.
+  std::atomic<std::size_t> misses_;
+
+  /// @brief The number of filtered operations.
+  std::atomic<std::size_t> filtered_;
+
+  /// @brief The number of entries replaced by another one.
+  std::atomic<std::size_t> discarded_;
+
+  /// @brief The number of results not stored because their slot was busy.
+  std::atomic<std::size_t> contended_;
+
+  /// @brief The statistics of this cache, computed on demand.
+  mutable cache_statistics stats_;
+
+public:
+
+  /// @brief Construct a cache.
+  /// @param context This cache's default context.
+  /// @param size How many cache entries can be kept.
+  ///
+  /// All the memory is allocated at construction.
+  concurrent_cache(context_type& context, std::size_t size)
+    : cxt_(context)
+    , nb_slots_(util::next_power_of_2(size))
+    , slots_(std::make_unique<slot[]>(nb_slots_))
+    , size_(0), hits_(0), misses_(0), filtered_(0), discarded_(0), contended_(0)
+    , stats_()
+  {}
+
+  /// @brief Destructor.
+  ~concurrent_cache()
+  {
+    clear();
+  }
+
+  /// @brief Cache lookup, evaluation in this cache's default context.
+  result_type
+  operator()(Operation&& op)
+  {
+    return (*this)(cxt_, std::move(op));
+  }
+
+  /// @brief Cache lookup, evaluation in a given context.
+  ///
+  /// The context is used when op has to be evaluated, it's typically the one of the calling
+  /// thread.
+  result_type
+  operator()(context_type& cxt, Operation&& op)
+  {
+    // Check if the current operation should be cached or not.
+    if (not apply_filters<Operation, Filters...>()(op))
+    {
+      ++filtered_;
+      return op(cxt);
+    }
+
+    const std::size_t hash = std::hash<Operation>()(op);
+    auto& s = slots_[hash & (nb_slots_ - 1)];
+
+    if (s.try_lock())
+    {
+      if (s.full and s.hash == hash and s.get().operation == op)
+      {
+        // Copy before unlocking, another thread might replace this entry right after.
+        result_type res = s.get().result;
+        s.unlock();
+        ++hits_;
+        return res;
+      }
+      s.unlock();
+    }
+
+    ++misses_;
+    auto res = op(cxt); // evaluation may throw
+
+    if (s.try_lock())
+    {
+      if (s.full)
+      {
+        s.get().~entry();
+        ++discarded_;
+      }
+      else
+      {
+        ++size_;
+      }
+      new (&s.storage) entry{std::move(op), res};
+      s.full = true;
+      s.hash = hash;
+      s.unlock();
+    }
+    else
+    {
+      ++contended_;
+    }
+    return res;
+  }
+
+  /// @brief Remove all entries of the cache.
+  ///
+  /// Must not be called while other threads are using this cache.
+  void
+  clear()
+  noexcept
+  {
+    for (std::size_t i = 0; i < nb_slots_; ++i)
+    {
+      auto& s = slots_[i];
+      if (s.full)
+      {
+        s.get().~entry();
+        s.full = false;
+      }
+    }
+    size_ = 0;
+  }
+
+  /// @brief Get the number of cached operations.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return size_;
+  }
+
+  /// @brief Get the number of results which were not stored because their slot was busy.
+  std::size_t
+  contended()
+  const noexcept
+  {
+    return contended_;
+  }
+
+  /// @brief Get the statistics of this cache.
+  ///
+  /// A slot can hold only one entry, thus there are never collisions.
+  const cache_statistics&
+  statistics()
+  const noexcept
+  {
+    stats_.size = size_;
+    stats_.hits = hits_;
+    stats_.misses = misses_;
+    stats_.filtered = filtered_;
+    stats_.discarded = discarded_;
+    stats_.collisions = 0;
+    stats_.alone = stats_.size;
+    stats_.empty = nb_slots_ - stats_.size;
+    stats_.buckets = nb_slots_;
+    stats_.load_factor = static_cast<double>(stats_.size) / static_cast<double>(nb_slots_);
+    return stats_;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::mem
@@ -6,7 +6,7 @@
 
 #pragma once
 
-#include <algorithm>   // fill
+#include <algorithm>   // fill, min
 #include <cassert>
 #include <functional>  // hash
 #include <memory>      // unique_ptr
@@ -37,7 +37,10 @@ struct intrusive_member_hook
 ///
 /// It's modeled after boost::intrusive. Only the interfaces needed by the libsdd are implemented.
 /// It uses chaining to handle collisions.
-template <typename Data, bool Rehash = true>
+/// @tparam Incremental If true, a rehash doesn't move all elements at once: each subsequent
+/// insertion migrates a few buckets of the previous table, which is searched until it's empty.
+/// Thus, the cost of an insertion is bounded, even for very large tables.
+template <typename Data, bool Rehash = true, bool Incremental = false>
 class hash_table
 {
 public:
@@ -65,6 +68,22 @@ private:
   /// @brief The number of times this hash table has been rehashed.
   std::size_t nb_rehash_;
 
+  /// @brief The buckets being migrated by an incremental rehash, nullptr if there are none.
+  std::unique_ptr<Data*[]> old_buckets_;
+
+  /// @brief The number of buckets being migrated.
+  std::size_t old_nb_buckets_;
+
+  /// @brief The number of buckets already migrated, starting from the first one.
+  std::size_t nb_migrated_;
+
+  /// @brief The number of buckets migrated by each insertion during an incremental rehash.
+  ///
+  /// The migration must be over before the next rehash. It begins with a load factor of
+  /// max_load_factor_/2, thus the next rehash happens after old_nb_buckets_*max_load_factor_
+  /// insertions at least.
+  static constexpr std::size_t migration_step = 4;
+
 public:
 
   hash_table(std::size_t size, double max_load_factor = 0.75)
@@ -73,6 +92,9 @@ public:
     , buckets_(std::make_unique<Data*[]>(nb_buckets_))
     , max_load_factor_(max_load_factor)
     , nb_rehash_(0)
+    , old_buckets_(nullptr)
+    , old_nb_buckets_(0)
+    , nb_migrated_(0)
   {
     std::fill(buckets_.get(), buckets_.get() + nb_buckets_, nullptr);
   }
@@ -81,10 +103,20 @@ public:
   std::pair<Data*, bool>
   insert_check(const T& x, EqT eq, insert_commit_data& commit_data)
   const noexcept(noexcept(std::hash<T>()(x)))
+  {
+    return insert_check(x, std::hash<T>()(x), eq, commit_data);
+  }
+
+  /// @brief Look for an element, using an already computed hash value.
+  /// @param hash Must be the same as the hash value of the searched element.
+  template <typename T, typename EqT>
+  std::pair<Data*, bool>
+  insert_check(const T& x, std::size_t hash, EqT eq, insert_commit_data& commit_data)
+  const noexcept
   {
     static_assert(not Rehash, "Use with fixed-size hash table only");
 
-    const std::size_t pos = std::hash<T>()(x) & (nb_buckets_ - 1);
+    const std::size_t pos = hash & (nb_buckets_ - 1);
 
     Data* current = buckets_[pos];
     commit_data.bucket = buckets_.get() + pos;
@@ -135,11 +167,55 @@ public:
   std::pair<Data*, bool>
   insert(Data* x)
   {
-    auto res = insert_impl(x, buckets_.get(), nb_buckets_);
+    const std::size_t hash = std::hash<Data>()(*x);
+    if (Incremental and migrating())
+    {
+      migrate(migration_step);
+      if (Data** bucket = old_bucket(hash))
+      {
+        for (Data* current = *bucket; current != nullptr; current = current->hook.next)
+        {
+          if (*x == *current)
+          {
+            return {current, false /* no insertion */};
+          }
+        }
+      }
+    }
+    auto res = insert_impl(x, hash, buckets_.get(), nb_buckets_);
     rehash();
     return res;
   }
 
+  /// @brief Look for an element without constructing it.
+  /// @param hash Must be the same as the hash value of the searched element.
+  /// @param eq Tell if an element of this table is the searched one.
+  /// @return The found element, or nullptr.
+  template <typename EqT>
+  Data*
+  find(std::size_t hash, EqT&& eq)
+  const noexcept
+  {
+    Data** bucket = Incremental ? old_bucket(hash) : nullptr;
+    for ( Data* current = bucket != nullptr ? *bucket : nullptr; current != nullptr
+        ; current = current->hook.next)
+    {
+      if (eq(*current))
+      {
+        return current;
+      }
+    }
+    for ( Data* current = buckets_[hash & (nb_buckets_ - 1)]; current != nullptr
+        ; current = current->hook.next)
+    {
+      if (eq(*current))
+      {
+        return current;
+      }
+    }
+    return nullptr;
+  }
+
   /// @brief Return the number of elements.
   std::size_t
   size()
@@ -156,33 +232,52 @@ public:
     return nb_buckets_;
   }
 
-  /// @brief Remove an element given its value.
+  /// @brief Remove an element.
   void
   erase(const Data* x)
   noexcept
   {
-    const std::size_t pos = std::hash<Data>()(*x) & (nb_buckets_ - 1);
+    const bool found = try_erase(x);
+    assert(found && "Data to erase not found");
+    (void)found;
+  }
+
+  /// @brief Remove an element if it's still stored in this table.
+  /// @return false if x was not found.
+  ///
+  /// Elements are identified by their address, not by their value: an element equal to x but
+  /// stored at a different address is left untouched.
+  bool
+  try_erase(const Data* x)
+  noexcept
+  {
+    const std::size_t hash = std::hash<Data>()(*x);
+    Data** bucket = Incremental ? old_bucket(hash) : nullptr;
+    if (bucket == nullptr)
+    {
+      bucket = buckets_.get() + (hash & (nb_buckets_ - 1));
+    }
     Data* previous = nullptr;
-    Data* current = buckets_[pos];
+    Data* current = *bucket;
     while (current != nullptr)
     {
-      if (*x == *current)
+      if (x == current)
       {
         if (previous == nullptr) // first element in bucket
         {
-          buckets_[pos] = current->hook.next;
+          *bucket = current->hook.next;
         }
         else
         {
           previous->hook.next = current->hook.next;
         }
         --size_;
-        return;
+        return true;
       }
       previous = current;
       current = current->hook.next;
     }
-    assert(false && "Data to erase not found");
+    return false;
   }
 
   /// @brief Clear the whole table.
@@ -190,20 +285,72 @@ public:
   void
   clear_and_dispose(Disposer disposer)
   {
-    for (std::size_t i = 0; i < nb_buckets_; ++i)
+    const auto dispose = [&](Data** buckets, std::size_t nb_buckets)
     {
-      Data* current = buckets_[i];
-      while (current != nullptr)
+      for (std::size_t i = 0; i < nb_buckets; ++i)
       {
-        const auto to_erase = current;
-        current = current->hook.next;
-        disposer(to_erase);
+        Data* current = buckets[i];
+        while (current != nullptr)
+        {
+          const auto to_erase = current;
+          current = current->hook.next;
+          disposer(to_erase);
+        }
+        buckets[i] = nullptr;
       }
-      buckets_[i] = nullptr;
+    };
+    if (migrating())
+    {
+      dispose(old_buckets_.get(), old_nb_buckets_);
+      end_migration();
     }
+    dispose(buckets_.get(), nb_buckets_);
     size_ = 0;
   }
 
+  /// @brief Remove and dispose all elements which satisfy a predicate.
+  /// @return The number of removed elements.
+  ///
+  /// An element is unlinked before being given to the disposer, which must not insert or erase
+  /// elements of this table. However, it may change the result of the predicate for other
+  /// elements, which are then removed if they are not visited yet.
+  template <typename Predicate, typename Disposer>
+  std::size_t
+  remove_and_dispose_if(Predicate pred, Disposer disposer)
+  {
+    const auto remove = [&](Data** buckets, std::size_t first, std::size_t last)
+    {
+      std::size_t nb_removed = 0;
+      for (std::size_t i = first; i < last; ++i)
+      {
+        Data** link = buckets + i;
+        while (*link != nullptr)
+        {
+          Data* current = *link;
+          if (pred(*current))
+          {
+            *link = current->hook.next;
+            ++nb_removed;
+            disposer(current);
+          }
+          else
+          {
+            link = &current->hook.next;
+          }
+        }
+      }
+      return nb_removed;
+    };
+    std::size_t nb_removed = 0;
+    if (migrating())
+    {
+      nb_removed += remove(old_buckets_.get(), nb_migrated_, old_nb_buckets_);
+    }
+    nb_removed += remove(buckets_.get(), 0, nb_buckets_);
+    size_ -= nb_removed;
+    return nb_removed;
+  }
+
   /// @brief Get the load factor of the internal hash table.
   double
   load_factor()
@@ -220,7 +367,17 @@ public:
     return nb_rehash_;
   }
 
+  /// @brief Tell if an incremental rehash is in progress.
+  bool
+  migrating()
+  const noexcept
+  {
+    return old_buckets_ != nullptr;
+  }
+
   /// @brief The number of collisions.
+  ///
+  /// Buckets being migrated by an incremental rehash are not taken into account.
   std::tuple<std::size_t /* collisions */, std::size_t /* alone */, std::size_t /* empty */>
   collisions()
   const noexcept
@@ -254,6 +411,19 @@ private:
       return;
     }
     ++nb_rehash_;
+    if (Incremental)
+    {
+      // Should not happen with a reasonable max_load_factor_, but it would be the case when
+      // elements are inserted faster than buckets are migrated.
+      migrate(old_nb_buckets_);
+      old_buckets_ = std::move(buckets_);
+      old_nb_buckets_ = nb_buckets_;
+      nb_migrated_ = 0;
+      nb_buckets_ *= 2;
+      buckets_ = std::make_unique<Data*[]>(nb_buckets_);
+      std::fill(buckets_.get(), buckets_.get() + nb_buckets_, nullptr);
+      return;
+    }
     auto new_nb_buckets = nb_buckets_ * 2;
     auto new_buckets = new Data*[new_nb_buckets];
     std::fill(new_buckets, new_buckets + new_nb_buckets, nullptr);
@@ -265,7 +435,7 @@ private:
       {
         Data* next = data_ptr->hook.next;
         data_ptr->hook.next = nullptr;
-        insert_impl(data_ptr, new_buckets, new_nb_buckets);
+        insert_impl(data_ptr, std::hash<Data>()(*data_ptr), new_buckets, new_nb_buckets);
         data_ptr = next;
       }
       // else empty bucket
@@ -274,12 +444,66 @@ private:
     nb_buckets_ = new_nb_buckets;
   }
 
+  /// @brief Get the bucket of the old table where an element is stored, if it's not migrated yet.
+  /// @return nullptr if there is no migration in progress or if the bucket was migrated.
+  Data**
+  old_bucket(std::size_t hash)
+  const noexcept
+  {
+    if (not migrating())
+    {
+      return nullptr;
+    }
+    const std::size_t pos = hash & (old_nb_buckets_ - 1);
+    return pos < nb_migrated_ ? nullptr : old_buckets_.get() + pos;
+  }
+
+  /// @brief Move some buckets of the old table into the current one.
+  void
+  migrate(std::size_t nb_buckets)
+  noexcept
+  {
+    if (not migrating())
+    {
+      return;
+    }
+    const auto end = std::min(old_nb_buckets_, nb_migrated_ + nb_buckets);
+    for (; nb_migrated_ < end; ++nb_migrated_)
+    {
+      Data* current = old_buckets_[nb_migrated_];
+      while (current != nullptr)
+      {
+        // No need to check for equality, elements of the old table are already unique.
+        Data* next = current->hook.next;
+        const std::size_t pos = std::hash<Data>()(*current) & (nb_buckets_ - 1);
+        current->hook.next = buckets_[pos];
+        buckets_[pos] = current;
+        current = next;
+      }
+      old_buckets_[nb_migrated_] = nullptr;
+    }
+    if (nb_migrated_ == old_nb_buckets_)
+    {
+      end_migration();
+    }
+  }
+
+  /// @brief Release the old table of an incremental rehash.
+  void
+  end_migration()
+  noexcept
+  {
+    old_buckets_.reset();
+    old_nb_buckets_ = 0;
+    nb_migrated_ = 0;
+  }
+
   /// @brief Insert an element.
   std::pair<Data*, bool>
-  insert_impl(Data* x, Data** buckets, std::size_t nb_buckets)
-  noexcept(noexcept(std::hash<Data>()(*x)))
+  insert_impl(Data* x, std::size_t hash, Data** buckets, std::size_t nb_buckets)
+  noexcept
   {
-    const std::size_t pos = std::hash<Data>()(*x) & (nb_buckets - 1);
+    const std::size_t pos = hash & (nb_buckets - 1);
 
     Data* current = buckets[pos];
 
@@ -7,7 +7,7 @@
 #pragma once
 
 #include <cassert>
-#include <functional>  // hash, function
+#include <functional>  // hash
 #include <type_traits> // remove_const
 
 #include "sdd/mem/unique_table.hh"
@@ -18,49 +18,71 @@ namespace sdd { namespace mem {
 /*------------------------------------------------------------------------------------------------*/
 
 /// @internal
-/// @brief Define the type of a deletion handler.
+/// @brief Erase the data of a given table type when they are no longer referenced.
+/// @tparam Table The type of the table which unifies the data.
 ///
-/// A deletion handler is called by ptr whenever a data is no longer referenced.
-template <typename Unique>
-using handler_type = std::function<void (const Unique*)>;
+/// The table is known at compile time, thus ptr directly calls its erase() method. The instance
+/// of the table is registered by the manager which owns it.
+template <typename Table>
+struct table_deleter
+{
+  /// @brief The table where data are unified, nullptr if there is none.
+  static Table* table;
+
+  /// @brief Erase a data which is no longer referenced.
+  template <typename Unique>
+  static
+  void
+  erase(const Unique* x)
+  noexcept
+  {
+    assert(table != nullptr && "Unset deletion table");
+    table->erase(x);
+  }
+};
+
+template <typename Table>
+Table* table_deleter<Table>::table = nullptr;
 
 /// @internal
-/// @brief Get the deletion handler for a given Unique type.
-template <typename Unique>
-handler_type<Unique>&
-deletion_handler()
+/// @brief Register the table which erases its data when they are no longer referenced.
+template <typename Table>
+void
+set_deletion_table(Table& t)
+noexcept
 {
-  static handler_type<Unique> handler = [](const Unique*){assert(false && "Unset handler");};
-  return handler;
+  table_deleter<Table>::table = &t;
 }
 
 /// @internal
-/// @brief Reset the deletion handler for a given Unique type.
-template <typename Unique>
+/// @brief Unregister the table which erases its data when they are no longer referenced.
+template <typename Table>
 void
-reset_deletion_handler()
+reset_deletion_table()
+noexcept
 {
-  deletion_handler<Unique>() = [](const Unique*){assert(false && "Reset handler");};
+  table_deleter<Table>::table = nullptr;
 }
 
+/*------------------------------------------------------------------------------------------------*/
 
 /// @internal
-/// @brief Set the deletion handler for a given Unique type.
-template <typename Unique>
-void
-set_deletion_handler(const handler_type<Unique>& h)
-{
-  deletion_handler<Unique>() = h;
-}
+/// @brief Tag to construct a ptr on a unified data whose reference has already been acquired.
+struct adopt_reference_t {};
+
+/// @internal
+/// @brief Tag to construct a ptr on a unified data whose reference has already been acquired.
+constexpr adopt_reference_t adopt_reference{};
 
 /*------------------------------------------------------------------------------------------------*/
 
 /// @internal
 /// @brief A smart pointer to manage unified ressources.
 /// @tparam Unique the type of the unified ressource.
+/// @tparam Deleter Erase a unified ressource when it's no longer referenced (see table_deleter).
 ///
 /// Unified ressources are ref_counted elements constructed with an unique_table.
-template <typename Unique>
+template <typename Unique, typename Deleter = table_deleter<unique_table<Unique>>>
 class ptr
 {
   // Can't default construct a ptr.
@@ -82,6 +104,12 @@ public:
     x_->increment_reference_counter();
   }
 
+  /// @brief Constructor with a unified data already referenced on behalf of this ptr.
+  ptr(Unique* p, adopt_reference_t)
+  noexcept
+    : x_(p)
+  {}
+
   /// @brief Copy constructor.
   ptr(const ptr& other)
   noexcept
@@ -99,10 +127,9 @@ public:
     assert(other.x_ != nullptr); // Don't copy from an already moved ptr.
     if (x_ != nullptr)
     {
-      x_->decrement_reference_counter();
-      if (x_->is_not_referenced())
+      if (x_->decrement_reference_counter())
       {
-        deletion_handler<Unique>()(x_);
+        Deleter::erase(x_);
       }
     }
     x_ = other.x_;
@@ -125,10 +152,9 @@ public:
   {
     if (x_ != nullptr)
     {
-      x_->decrement_reference_counter();
-      if (x_->is_not_referenced())
+      if (x_->decrement_reference_counter())
       {
-        deletion_handler<Unique>()(x_);
+        Deleter::erase(x_);
       }
     }
     x_ = other.x_;
@@ -141,10 +167,9 @@ public:
   {
     if (x_ != nullptr)
     {
-      x_->decrement_reference_counter();
-      if (x_->is_not_referenced())
+      if (x_->decrement_reference_counter())
       {
-        deletion_handler<Unique>()(x_);
+        Deleter::erase(x_);
       }
     }
   }
@@ -211,6 +236,40 @@ public:
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Unify a data with a unique_table and get a ptr on the result.
+/// @related ptr
+template <typename Unique, bool IncrementalRehash>
+inline
+ptr<Unique, table_deleter<unique_table<Unique, IncrementalRehash>>>
+make_ptr(unique_table<Unique, IncrementalRehash>& table, Unique* x, std::size_t extra_bytes)
+{
+  using table_type = unique_table<Unique, IncrementalRehash>;
+  return ptr<Unique, table_deleter<table_type>>(&table(x, extra_bytes));
+}
+
+/// @internal
+/// @brief Get a ptr on a data, which is constructed only if it's not already unified.
+/// @param hash The hash value of the data.
+/// @param eq Tell if a unified data is the wanted one.
+/// @param construct Construct the data at the address it's given, and return it.
+/// @related ptr
+template <typename Unique, bool IncrementalRehash, typename EqT, typename Construct>
+inline
+ptr<Unique, table_deleter<unique_table<Unique, IncrementalRehash>>>
+make_ptr( unique_table<Unique, IncrementalRehash>& table, std::size_t hash, EqT&& eq
+        , std::size_t extra_bytes, Construct&& construct)
+{
+  using table_type = unique_table<Unique, IncrementalRehash>;
+  if (Unique* x = table.find(hash, eq))
+  {
+    return ptr<Unique, table_deleter<table_type>>(x);
+  }
+  return make_ptr(table, construct(table.allocate(extra_bytes)), extra_bytes);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 }} // namespace sdd::mem
 
 namespace std {
@@ -219,11 +278,11 @@ namespace std {
 
 /// @internal
 /// @brief Hash specialization for sdd::mem::ptr
-template <typename Unique>
-struct hash<sdd::mem::ptr<Unique>>
+template <typename Unique, typename Deleter>
+struct hash<sdd::mem::ptr<Unique, Deleter>>
 {
   std::size_t
-  operator()(const sdd::mem::ptr<Unique>& x)
+  operator()(const sdd::mem::ptr<Unique, Deleter>& x)
   const noexcept
   {
     return sdd::hash::seed(x.operator->());
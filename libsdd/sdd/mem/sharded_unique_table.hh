@@ -0,0 +1,299 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm>  // max
+#include <cassert>
+#include <cstdint>    // uint64_t
+#include <functional> // hash
+#include <memory>     // unique_ptr
+#include <mutex>
+#include <tuple>      // tie
+
+#include "sdd/mem/hash_table.hh"
+#include "sdd/mem/ptr.hh"
+#include "sdd/mem/unique_table.hh"
+
+namespace sdd { namespace mem {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A table to unify data which can be shared by several threads.
+/// @tparam Unique The type of the unified data; it must use an atomic reference counter.
+/// @tparam Shards The number of independent sub-tables, must be a power of 2.
+///
+/// The table is split into shards, each one protected by its own mutex. A data is always stored
+/// in the same shard, which is selected with the highest bits of its (mixed) hash value, while
+/// the underlying hash tables use the lowest ones.
+///
+/// To be safe, a reference on the unified data is acquired while the shard is still locked: it's
+/// the only way to prevent another thread from releasing it in the meantime. Thus, the result of
+/// operator() must be adopted by a ptr (see make_ptr()). A data whose reference counter dropped to
+/// 0 is considered dead, even if it's still in the table because its erasure is pending: a
+/// lookup which finds it unlinks it and stores the new data instead.
+template <typename Unique, std::size_t Shards = 64>
+class sharded_unique_table
+{
+  static_assert(Shards != 0 and (Shards & (Shards - 1)) == 0, "Shards must be a power of 2");
+  static_assert(Shards <= (1ull << 32), "Too many shards");
+
+  // Can't copy a sharded_unique_table.
+  sharded_unique_table(const sharded_unique_table&) = delete;
+  sharded_unique_table& operator=(const sharded_unique_table&) = delete;
+
+private:
+
+  /// @brief A sub-table.
+  struct shard
+  {
+    /// @brief Protect all accesses to this shard.
+    mutable std::mutex mutex;
+
+    /// @brief The actual container of unified data.
+    mem::hash_table<Unique> set;
+
+    /// @brief The total number of access.
+    std::size_t access = 0;
+
+    /// @brief The number of hits.
+    std::size_t hits = 0;
+
+    /// @brief The number of misses.
+    std::size_t misses = 0;
+
+    /// @brief The maximum number of stored elements.
+    std::size_t peak = 0;
+
+    shard(std::size_t initial_size)
+      : mutex(), set(initial_size)
+    {}
+  };
+
+  /// @brief The sub-tables.
+  std::unique_ptr<std::unique_ptr<shard>[]> shards_;
+
+  /// @brief The statistics of this table, computed on demand.
+  mutable unique_table_statistics stats_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param initial_size Initial capacity of the whole container.
+  /// @param collection_threshold Not used, a data is always destroyed as soon as it's no longer
+  /// referenced: a dead data can't be resurrected by another thread.
+  sharded_unique_table(std::size_t initial_size, std::size_t /*collection_threshold*/ = 0)
+    : shards_(std::make_unique<std::unique_ptr<shard>[]>(Shards)), stats_()
+  {
+    const auto shard_size = std::max(initial_size / Shards, static_cast<std::size_t>(1));
+    for (std::size_t i = 0; i < Shards; ++i)
+    {
+      shards_[i] = std::make_unique<shard>(shard_size);
+    }
+  }
+
+  /// @brief Unify a data and acquire a reference on the result.
+  /// @param ptr A pointer to a data constructed with a placement new into the storage returned by
+  /// allocate().
+  /// @param extra_bytes Not used, only needed to have the same interface as unique_table.
+  /// @return A reference to the unified data, whose reference counter has been incremented.
+  Unique&
+  operator()(Unique* ptr, std::size_t /*extra_bytes*/)
+  {
+    assert(ptr != nullptr);
+    auto& s = shard_of(*ptr);
+    Unique* res = nullptr;
+    {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      ++s.access;
+      auto insertion = s.set.insert(ptr);
+      if (not insertion.second and insertion.first->try_increment_reference_counter())
+      {
+        ++s.hits;
+        res = insertion.first;
+      }
+      else
+      {
+        if (not insertion.second)
+        {
+          // The existing data is about to be erased by the thread which released it, replace it.
+          s.set.erase(insertion.first);
+          s.set.insert(ptr);
+        }
+        ++s.misses;
+        s.peak = std::max(s.peak, s.set.size());
+        res = ptr;
+        res->increment_reference_counter();
+      }
+    }
+    if (res != ptr)
+    {
+      ptr->~Unique();
+      delete[] reinterpret_cast<char*>(ptr); // match new char[] of allocate().
+    }
+    return *res;
+  }
+
+  /// @brief Look for a unified data without constructing it, and acquire a reference on it.
+  /// @param hash The hash value of the searched data.
+  /// @param eq Tell if the data of a unified element is the searched one.
+  /// @return The unified data, or nullptr if it must be constructed and unified with operator().
+  ///
+  /// Only a hit is accounted, the subsequent unification accounts for a miss.
+  template <typename EqT>
+  Unique*
+  find(std::size_t hash, EqT&& eq)
+  {
+    auto& s = shard_of(hash);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    Unique* res = s.set.find(hash, [&](const Unique& x)
+                                     {
+                                       return x.hash() == hash and eq(x.data());
+                                     });
+    // A data which is about to be erased by another thread is not found.
+    if (res != nullptr and res->try_increment_reference_counter())
+    {
+      ++s.access;
+      ++s.hits;
+      return res;
+    }
+    return nullptr;
+  }
+
+  /// @brief Allocate a memory block large enough for the given size.
+  char*
+  allocate(std::size_t extra_bytes)
+  {
+    return new char[sizeof(Unique) + extra_bytes];
+  }
+
+  /// @brief Erase the given unified data.
+  ///
+  /// All subsequent uses of the erased data are invalid.
+  void
+  erase(const Unique* x)
+  noexcept
+  {
+    assert(x != nullptr);
+    {
+      auto& s = shard_of(*x);
+      std::lock_guard<std::mutex> lock(s.mutex);
+      // Checked under the lock as a concurrent lookup might have temporarily incremented it.
+      assert(x->is_not_referenced() && "Unique still referenced");
+      // x might have already been replaced by another thread.
+      s.set.try_erase(x);
+    }
+    // Destroy outside of the lock as it might release other data stored in the same shard.
+    x->~Unique();
+    delete[] reinterpret_cast<const char*>(x); // match new char[] of allocate().
+  }
+
+  /// @brief Destroy all unreferenced data.
+  /// @return Always 0, as no unreferenced data is kept by this table.
+  std::size_t
+  collect()
+  const noexcept
+  {
+    return 0;
+  }
+
+  /// @brief Get the statistics of this table.
+  ///
+  /// The peak is the sum of the peaks of all shards.
+  const unique_table_statistics&
+  stats()
+  const noexcept
+  {
+    stats_ = unique_table_statistics();
+    for (std::size_t i = 0; i < Shards; ++i)
+    {
+      const auto& s = *shards_[i];
+      std::lock_guard<std::mutex> lock(s.mutex);
+      std::size_t collisions, alone, empty;
+      std::tie(collisions, alone, empty) = s.set.collisions();
+      stats_.size += s.set.size();
+      stats_.peak += s.peak;
+      stats_.access += s.access;
+      stats_.hits += s.hits;
+      stats_.misses += s.misses;
+      stats_.rehash += s.set.nb_rehash();
+      stats_.collisions += collisions;
+      stats_.alone += alone;
+      stats_.empty += empty;
+      stats_.buckets += s.set.bucket_count();
+    }
+    stats_.load_factor = static_cast<double>(stats_.size) / static_cast<double>(stats_.buckets);
+    return stats_;
+  }
+
+private:
+
+  /// @brief Get the shard where a data is stored.
+  shard&
+  shard_of(const Unique& x)
+  const noexcept
+  {
+    return shard_of(std::hash<Unique>()(x));
+  }
+
+  /// @brief Get the shard where a data with a given hash value is stored.
+  shard&
+  shard_of(std::size_t hash)
+  const noexcept
+  {
+    // Fibonacci hashing, to spread the hash values on the highest bits.
+    const auto h = static_cast<std::uint64_t>(hash) * 0x9e3779b97f4a7c15ull;
+    return *shards_[static_cast<std::size_t>((h >> 32) >> (32 - log2(Shards))) & (Shards - 1)];
+  }
+
+  /// @brief Compute the logarithm of a power of 2.
+  static constexpr
+  std::size_t
+  log2(std::size_t x)
+  noexcept
+  {
+    return x <= 1 ? 0 : 1 + log2(x / 2);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Unify a data with a sharded_unique_table and get a ptr on the result.
+/// @related sharded_unique_table
+template <typename Unique, std::size_t Shards>
+inline
+ptr<Unique, table_deleter<sharded_unique_table<Unique, Shards>>>
+make_ptr(sharded_unique_table<Unique, Shards>& table, Unique* x, std::size_t extra_bytes)
+{
+  using table_type = sharded_unique_table<Unique, Shards>;
+  return ptr<Unique, table_deleter<table_type>>(&table(x, extra_bytes), adopt_reference);
+}
+
+/// @internal
+/// @brief Get a ptr on a data, which is constructed only if it's not already unified.
+/// @param hash The hash value of the data.
+/// @param eq Tell if a unified data is the wanted one.
+/// @param construct Construct the data at the address it's given, and return it.
+/// @related sharded_unique_table
+template <typename Unique, std::size_t Shards, typename EqT, typename Construct>
+inline
+ptr<Unique, table_deleter<sharded_unique_table<Unique, Shards>>>
+make_ptr( sharded_unique_table<Unique, Shards>& table, std::size_t hash, EqT&& eq
+        , std::size_t extra_bytes, Construct&& construct)
+{
+  using table_type = sharded_unique_table<Unique, Shards>;
+  if (Unique* x = table.find(hash, eq))
+  {
+    return ptr<Unique, table_deleter<table_type>>(x, adopt_reference);
+  }
+  return make_ptr(table, construct(table.allocate(extra_bytes)), extra_bytes);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::mem
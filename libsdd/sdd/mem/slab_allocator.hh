@@ -0,0 +1,147 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory> // unique_ptr
+#include <vector>
+
+namespace sdd { namespace mem {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief An allocator of variable-size blocks, which groups them by size classes.
+///
+/// Each block is preceded by a header which stores its size class, thus deallocate() doesn't
+/// need the size of the block. Small blocks are carved out of large chunks and, once released,
+/// they are kept in the free list of their size class to be reused by blocks of the same class.
+/// Chunks are only released with the allocator. Blocks larger than max_small_size are directly
+/// allocated with new.
+class slab_allocator
+{
+  // Can't copy a slab_allocator.
+  slab_allocator(const slab_allocator&) = delete;
+  slab_allocator& operator=(const slab_allocator&) = delete;
+
+public:
+
+  /// @brief The alignment of all blocks, and the difference between two consecutive size classes.
+  static constexpr std::size_t alignment = alignof(std::size_t);
+
+  /// @brief The size of the largest block managed by size classes.
+  static constexpr std::size_t max_small_size = 4096;
+
+private:
+
+  /// @brief Store the size class of a block, 0 for a large block.
+  using header_type = std::size_t;
+
+  static_assert(sizeof(header_type) % alignment == 0, "Header breaks alignment");
+
+  /// @brief A released block, stored in the free list of its size class.
+  struct free_block
+  {
+    free_block* next;
+  };
+
+  /// @brief The size of a chunk.
+  const std::size_t chunk_size_;
+
+  /// @brief All chunks, released with the allocator.
+  std::vector<std::unique_ptr<char[]>> chunks_;
+
+  /// @brief The beginning of the unused part of the current chunk.
+  char* position_;
+
+  /// @brief The end of the current chunk.
+  char* end_;
+
+  /// @brief The free list of each size class.
+  std::vector<free_block*> free_lists_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param chunk_size The size of the chunks from which small blocks are carved out.
+  slab_allocator(std::size_t chunk_size = 1024 * 1024)
+    : chunk_size_(chunk_size)
+    , chunks_()
+    , position_(nullptr)
+    , end_(nullptr)
+    , free_lists_(max_small_size / alignment + 1, nullptr)
+  {
+    assert(chunk_size_ >= max_small_size + sizeof(header_type));
+  }
+
+  /// @brief Allocate a block of at least size bytes.
+  char*
+  allocate(std::size_t size)
+  {
+    const auto size_class = (size + alignment - 1) / alignment;
+    if (size_class * alignment > max_small_size)
+    {
+      auto block = new char[sizeof(header_type) + size];
+      *reinterpret_cast<header_type*>(block) = 0;
+      return block + sizeof(header_type);
+    }
+
+    const auto class_idx = size_class == 0 ? 1 : size_class;
+    if (free_lists_[class_idx] != nullptr)
+    {
+      auto block = free_lists_[class_idx];
+      free_lists_[class_idx] = block->next;
+      return reinterpret_cast<char*>(block);
+    }
+
+    const auto block_size = sizeof(header_type) + class_idx * alignment;
+    if (static_cast<std::size_t>(end_ - position_) < block_size)
+    {
+      // The end of the current chunk, if any, is lost.
+      chunks_.emplace_back(new char[chunk_size_]);
+      position_ = chunks_.back().get();
+      end_ = position_ + chunk_size_;
+    }
+    auto block = position_;
+    position_ += block_size;
+    *reinterpret_cast<header_type*>(block) = class_idx;
+    return block + sizeof(header_type);
+  }
+
+  /// @brief Release a block returned by allocate().
+  void
+  deallocate(char* ptr)
+  noexcept
+  {
+    assert(ptr != nullptr);
+    const auto class_idx = *reinterpret_cast<header_type*>(ptr - sizeof(header_type));
+    if (class_idx == 0)
+    {
+      delete[] (ptr - sizeof(header_type));
+    }
+    else
+    {
+      assert(class_idx < free_lists_.size());
+      auto block = reinterpret_cast<free_block*>(ptr);
+      block->next = free_lists_[class_idx];
+      free_lists_[class_idx] = block;
+    }
+  }
+
+  /// @brief The number of chunks allocated so far.
+  std::size_t
+  nb_chunks()
+  const noexcept
+  {
+    return chunks_.size();
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::mem
@@ -11,7 +11,7 @@
 #include <functional>  // hash
 #include <limits>      // numeric_limits
 #include <type_traits> // is_nothrow_constructible
-#include <utility>     // forward
+#include <utility>     // declval, forward
 
 #include "sdd/util/packed.hh"
 
@@ -19,12 +19,24 @@ namespace sdd { namespace mem {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Tag to construct a unique whose hash value has already been computed.
+struct precomputed_hash_t {};
+
+/// @internal
+/// @brief Tag to construct a unique whose hash value has already been computed.
+constexpr precomputed_hash_t precomputed_hash{};
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 /// @brief A wrapper to associate a reference counter to a unified data.
 ///
 /// This type is meant to be used by ptr, which takes care of incrementing and decrementing
 /// the reference counter, as well as the deletion of the held data.
-template <typename T>
+/// @tparam RefCount The type of the reference counter; std::atomic<std::uint32_t> makes it safe
+/// to share a unified data between several threads.
+template <typename T, typename RefCount = std::uint32_t>
 class
 #ifdef __clang__
 LIBSDD_ATTRIBUTE_PACKED
@@ -47,10 +59,15 @@ private:
   /// @brief Used by mem::hash_table to store some informations.
   mem::intrusive_member_hook<unique> hook;
 
+  /// @brief The hash value of data_, computed once at construction.
+  ///
+  /// It makes erasure and rehash of a table cheap, as they don't need to hash data_ again.
+  std::size_t hash_;
+
   /// @brief The number of time the encapsulated data is referenced
   ///
   /// Implements a reference-counting garbage collection.
-  std::uint32_t ref_count_;
+  RefCount ref_count_;
 
   /// @brief The garbage collected data.
   ///
@@ -62,9 +79,24 @@ public:
   
   template <typename... Args>
   unique(Args&&... args)
+  noexcept(    std::is_nothrow_constructible<T, Args...>::value
+           and noexcept(std::hash<T>()(std::declval<const T&>())))
+    : hook(), hash_(0), ref_count_(0), data_(std::forward<Args>(args)...)
+  {
+    // data_ is the last field, its hash can't be computed in the initialization list.
+    hash_ = std::hash<T>()(data_);
+  }
+
+  /// @brief Constructor with the hash value of the data to construct.
+  ///
+  /// Used when the hash value has been computed to look for the data in a table.
+  template <typename... Args>
+  unique(precomputed_hash_t, std::size_t hash, Args&&... args)
   noexcept(std::is_nothrow_constructible<T, Args...>::value)
-    : hook(), ref_count_(0), data_(std::forward<Args>(args)...)
-  {}
+    : hook(), hash_(hash), ref_count_(0), data_(std::forward<Args>(args)...)
+  {
+    assert(hash_ == std::hash<T>()(data_) && "Invalid precomputed hash value");
+  }
 
   /// @brief Get a reference of the unified data.
   const T&
@@ -74,6 +106,14 @@ public:
     return data_;
   }
 
+  /// @brief Get the hash value of the unified data.
+  std::size_t
+  hash()
+  const noexcept
+  {
+    return hash_;
+  }
+
   /// @brief Tell if the unified data is no longer referenced.
   bool
   is_not_referenced()
@@ -83,12 +123,14 @@ public:
   }
 
   /// @brief Equality.
+  ///
+  /// Hash values are compared first to avoid most deep comparisons of different data.
   friend
   bool
   operator==(const unique& lhs, const unique& rhs)
   noexcept
   {
-    return lhs.data_ == rhs.data_;
+    return lhs.hash_ == rhs.hash_ and lhs.data_ == rhs.data_;
   }
 
   /// @brief A ptr references that unified data.
@@ -100,17 +142,38 @@ public:
     ++ref_count_;
   }
 
+  /// @brief A ptr references that unified data, unless it's no longer referenced at all.
+  /// @return false if the data was no longer referenced, the reference counter is then unchanged.
+  ///
+  /// Used by tables shared by several threads, where a data found in the table might have been
+  /// released by another thread in the meantime.
+  bool
+  try_increment_reference_counter()
+  noexcept
+  {
+    if (ref_count_++ == 0)
+    {
+      --ref_count_;
+      return false;
+    }
+    return true;
+  }
+
   /// @brief A ptr no longer references that unified data.
-  void
+  /// @return true if this data is no longer referenced at all.
+  ///
+  /// The returned value is computed with the decrement itself, thus it is meaningful even when
+  /// several threads release the same data.
+  bool
   decrement_reference_counter()
   noexcept
   {
     assert(ref_count_ > 0);
-    --ref_count_;
+    return --ref_count_ == 0;
   }
 
   // hash_table needs to access the hook.
-  template <typename, bool> friend class hash_table;
+  template <typename, bool, bool> friend class hash_table;
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -123,14 +186,14 @@ namespace std {
 
 /// @internal
 /// @brief Hash specialization for sdd::mem::unique
-template <typename T>
-struct hash<sdd::mem::unique<T>>
+template <typename T, typename RefCount>
+struct hash<sdd::mem::unique<T, RefCount>>
 {
   std::size_t
-  operator()(const sdd::mem::unique<T>& x)
-  const noexcept(noexcept(hash<T>()(x.data())))
+  operator()(const sdd::mem::unique<T, RefCount>& x)
+  const noexcept
   {
-    return hash<T>()(x.data());
+    return x.hash();
   }
 };
 
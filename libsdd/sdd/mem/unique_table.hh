@@ -7,9 +7,9 @@
 #pragma once
 
 #include <cassert>
-#include <memory> // unique_ptr
 
 #include "sdd/mem/hash_table.hh"
+#include "sdd/mem/slab_allocator.hh"
 
 namespace sdd { namespace mem {
 
@@ -50,15 +50,36 @@ struct unique_table_statistics
 
   /// @brief The number of buckets in the underlying hash table.
   std::size_t buckets;
+
+  /// @brief The number of unreferenced elements waiting for a collection.
+  std::size_t dead;
+
+  /// @brief The number of unreferenced elements found again by a lookup before a collection.
+  std::size_t resurrected;
+
+  /// @brief The number of elements destroyed by collections.
+  std::size_t collected;
 };
 
 /*------------------------------------------------------------------------------------------------*/
 
 /// @internal
 /// @brief A table to unify data.
-template <typename Unique>
+/// @tparam IncrementalRehash If true, the underlying hash table is rehashed incrementally, to
+/// avoid long pauses when it grows.
+///
+/// When a collection threshold is given, a data which is no longer referenced is not destroyed
+/// immediately: it stays in the table and it's resurrected if it's unified again before the next
+/// collection.
+///
+/// The memory of unified data is managed by a slab_allocator: it's released all at once with
+/// the table.
+template <typename Unique, bool IncrementalRehash = false>
 class unique_table
 {
+  static_assert( alignof(Unique) <= slab_allocator::alignment
+               , "Unique is not sufficiently aligned by slab_allocator");
+
   // Can't copy a unique_table.
   unique_table(const unique_table&) = delete;
   unique_table& operator=(const unique_table&) = delete;
@@ -66,53 +87,69 @@ class unique_table
 private:
 
   /// @brief The actual container of unified data.
-  mem::hash_table<Unique> set_;
+  mem::hash_table<Unique, true /* rehash */, IncrementalRehash> set_;
 
   /// @brief The statistics of this unique_table.
   mutable unique_table_statistics stats_;
 
-  /// @brief Keep the memory of an insertion that was a hit.
-  std::unique_ptr<char[]> cache_;
+  /// @brief Allocate the memory of unified data.
+  slab_allocator allocator_;
+
+  /// @brief The number of unreferenced data which triggers a collection, 0 to never defer.
+  const std::size_t collection_threshold_;
 
-  /// @brief The number of bytes of the cached memory.
-  std::size_t cache_size_;
+  /// @brief The number of unreferenced data still stored in the table.
+  std::size_t nb_dead_;
 
 public:
 
   /// @brief Constructor.
   /// @param initial_size Initial capacity of the container.
-  unique_table(std::size_t initial_size)
-    : set_(initial_size), stats_(), cache_(nullptr), cache_size_(0)
+  /// @param collection_threshold The number of unreferenced data kept before they are collected;
+  /// 0 destroys a data as soon as it's no longer referenced.
+  unique_table(std::size_t initial_size, std::size_t collection_threshold = 0)
+    : set_(initial_size), stats_(), allocator_()
+    , collection_threshold_(collection_threshold), nb_dead_(0)
   {}
 
+  /// @brief Destructor.
+  ///
+  /// Destroy the unreferenced data which were not collected yet.
+  ~unique_table()
+  {
+    collect();
+  }
+
   /// @brief Unify a data.
   /// @param ptr A pointer to a data constructed with a placement new into the storage returned by
   /// allocate().
-  /// @param extra_bytes ptr might have been allocated with more bytes than sizeof(Unique); this
-  /// parameter indicates this extra number of bytes.
+  /// @param extra_bytes Not used, the allocator knows the size of all blocks.
   /// @return A reference to the unified data.
   Unique&
-  operator()(Unique* ptr, std::size_t extra_bytes)
+  operator()(Unique* ptr, std::size_t /*extra_bytes*/)
   {
     assert(ptr != nullptr);
     ++stats_.access;
 
+    if (nb_dead_ != 0 and nb_dead_ >= collection_threshold_)
+    {
+      // Must be done before ptr is inserted, as it's not referenced yet.
+      collect();
+    }
+
     auto insertion = set_.insert(ptr);
     if (not insertion.second) // ptr already exists
     {
       ++stats_.hits;
-      ptr->~Unique();
-      if ((sizeof(Unique) + extra_bytes) > cache_size_)
-      {
-        // The inserted ptr's memory to cache is bigger than the previously held cache. Thus it
-        // might fit better allocations request by allocate().
-        cache_.reset(reinterpret_cast<char*>(ptr));
-        cache_size_ = sizeof(Unique) + extra_bytes;
-      }
-      else
+      if (collection_threshold_ != 0 and insertion.first->is_not_referenced())
       {
-        delete[] reinterpret_cast<char*>(ptr);  // match new char[] of allocate().
+        // It will be referenced again by the caller.
+        --nb_dead_;
+        ++stats_.resurrected;
       }
+      ptr->~Unique();
+      // Its memory will be reused by the next allocation of the same size.
+      deallocate(ptr);
     }
     else
     {
@@ -122,37 +159,92 @@ public:
     return *insertion.first;
   }
 
+  /// @brief Look for a unified data without constructing it.
+  /// @param hash The hash value of the searched data.
+  /// @param eq Tell if the data of a unified element is the searched one.
+  /// @return The unified data, or nullptr if it must be constructed and unified with operator().
+  ///
+  /// Only a hit is accounted, the subsequent unification accounts for a miss.
+  template <typename EqT>
+  Unique*
+  find(std::size_t hash, EqT&& eq)
+  {
+    Unique* res = set_.find(hash, [&](const Unique& x)
+                                    {
+                                      return x.hash() == hash and eq(x.data());
+                                    });
+    if (res != nullptr)
+    {
+      ++stats_.access;
+      ++stats_.hits;
+      if (collection_threshold_ != 0 and res->is_not_referenced())
+      {
+        // It will be referenced again by the caller.
+        --nb_dead_;
+        ++stats_.resurrected;
+      }
+    }
+    return res;
+  }
+
   /// @brief Allocate a memory block large enough for the given size.
   char*
   allocate(std::size_t extra_bytes)
   {
-    if (cache_ and cache_size_ >= (sizeof(Unique) + extra_bytes))
-    {
-      // re-use cached allocation
-      auto res = cache_.get();
-      cache_.release();
-      cache_size_ = 0;
-      return res;
-    }
-    else
-    {
-      // no cached allocation or it was too small
-      return new char[sizeof(Unique) + extra_bytes];
-    }
+    return allocator_.allocate(sizeof(Unique) + extra_bytes);
   }
 
   /// @brief Erase the given unified data.
   ///
-  /// All subsequent uses of the erased data are invalid.
+  /// All subsequent uses of the erased data are invalid. If collections are deferred, the data
+  /// is only destroyed by the next collection, unless it's unified again before.
   void
   erase(const Unique* x)
   noexcept
   {
     assert(x != nullptr);
     assert(x->is_not_referenced() && "Unique still referenced");
+    if (collection_threshold_ != 0)
+    {
+      ++nb_dead_;
+      return;
+    }
     set_.erase(x);
     x->~Unique();
-    delete[] reinterpret_cast<const char*>(x); // match new char[] of allocate().
+    deallocate(x);
+  }
+
+  /// @brief Destroy all unreferenced data.
+  /// @return The number of destroyed data.
+  std::size_t
+  collect()
+  noexcept
+  {
+    std::size_t nb_collected = 0;
+    // Destroying a data can release other ones, which are then detected by a subsequent pass
+    // if they were already visited.
+    while (nb_dead_ != 0)
+    {
+      const auto nb = set_.remove_and_dispose_if( [](const Unique& x)
+                                                    {
+                                                      return x.is_not_referenced();
+                                                    }
+                                                , [this](Unique* x)
+                                                    {
+                                                      // Can call erase() on children.
+                                                      --nb_dead_;
+                                                      x->~Unique();
+                                                      deallocate(x);
+                                                    });
+      if (nb == 0)
+      {
+        assert(false && "Dead data not found");
+        break;
+      }
+      nb_collected += nb;
+    }
+    stats_.collected += nb_collected;
+    return nb_collected;
   }
 
   /// @brief Get the statistics of this unique_table.
@@ -165,8 +257,19 @@ public:
     stats_.rehash = set_.nb_rehash();
     std::tie(stats_.collisions, stats_.alone, stats_.empty) = set_.collisions();
     stats_.buckets = set_.bucket_count();
+    stats_.dead = nb_dead_;
     return stats_;
   }
+
+private:
+
+  /// @brief Release the memory of a destroyed data.
+  void
+  deallocate(const Unique* x)
+  noexcept
+  {
+    allocator_.deallocate(reinterpret_cast<char*>(const_cast<Unique*>(x)));
+  }
 };
 
 /*------------------------------------------------------------------------------------------------*/
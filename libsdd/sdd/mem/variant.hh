@@ -75,6 +75,28 @@ struct LIBSDD_ATTRIBUTE_PACKED variant
     new (const_cast<storage_type*>(&storage)) T{std::forward<Args>(args)...};
   }
 
+  /// @brief Compute the hash value of a variant holding a T, from the hash value of the T.
+  ///
+  /// It makes it possible to look for a variant in a table without constructing it.
+  template <typename T>
+  static
+  std::size_t
+  hash_of(std::size_t held_hash)
+  noexcept
+  {
+    return hash_with_index(held_hash, util::index_of<T, Types...>::value);
+  }
+
+  /// @brief Compute the hash value of a variant from the hash value of its held data.
+  static
+  std::size_t
+  hash_with_index(std::size_t held_hash, uint8_t index)
+  noexcept
+  {
+    using namespace sdd::hash;
+    return seed(held_hash) (val(index));
+  }
+
   /// @brief Destructor.
   ~variant()
   {
@@ -180,8 +202,8 @@ struct hash<sdd::mem::variant<Types...>>
   operator()(const sdd::mem::variant<Types...>& x)
   const
   {
-    using namespace sdd::hash;
-    return seed(apply_visitor(sdd::mem::hash_visitor{}, x)) (val(x.index));
+    return sdd::mem::variant<Types...>::hash_with_index( apply_visitor(sdd::mem::hash_visitor{}, x)
+                                                       , x.index);
   }
 };
 
@@ -71,6 +71,18 @@ struct hom_to_dot_visitor
     return node("h", &h);
   }
 
+  template <typename User>
+  std::string
+  operator()(const hom::_static_function<C, User>& h)
+  const
+  {
+    if (not visited(h))
+    {
+      os_ << node("h", &h) << " [label=\"" << h << "\"];\n";
+    }
+    return node("h", &h);
+  }
+
   std::string
   operator()(const hom::_identity<C>&)
   const
@@ -63,6 +63,18 @@ struct hom_to_json_visitor
     value.AddMember("name", s, allocator);
   }
 
+  template <typename User>
+  void
+  operator()(const hom::_static_function<C, User>& h)
+  const
+  {
+    std::stringstream ss;
+    ss << h;
+    rapidjson::Value s;
+    s.SetString(ss.str().c_str(), static_cast<rapidjson::SizeType>(ss.str().size()), allocator);
+    value.AddMember("name", s, allocator);
+  }
+
   void
   operator()(const hom::_identity<C>&)
   const
@@ -21,6 +21,7 @@ private:
 
   mem::unique_table_statistics sdd_ut_;
   mem::cache_statistics diff_cache_;
+  mem::cache_statistics diff_sum_cache_;
   mem::cache_statistics inter_cache_;
   mem::cache_statistics sum_cache_;
   mem::unique_table_statistics hom_ut_;
@@ -32,6 +33,7 @@ public:
   manager_statistics(const manager<C>& m)
     : sdd_ut_(m.sdd_stats())
     , diff_cache_(m.sdd_difference_cache_stats())
+    , diff_sum_cache_(m.sdd_difference_sum_cache_stats())
     , inter_cache_(m.sdd_intersection_cache_stats())
     , sum_cache_(m.sdd_sum_cache_stats())
     , hom_ut_(m.hom_stats())
@@ -41,6 +43,7 @@ public:
 
   const mem::unique_table_statistics& sdd_ut()    const noexcept {return sdd_ut_;}
   const mem::cache_statistics& diff_cache()       const noexcept {return diff_cache_;}
+  const mem::cache_statistics& diff_sum_cache()   const noexcept {return diff_sum_cache_;}
   const mem::cache_statistics& inter_cache()      const noexcept {return inter_cache_;}
   const mem::cache_statistics& sum_cache()        const noexcept {return sum_cache_;}
   const mem::unique_table_statistics& hom_ut()    const noexcept {return hom_ut_;}
@@ -38,6 +38,9 @@ save(Archive& archive, const unique_table_statistics& s)
          , cereal::make_nvp("# alone", s.alone)
          , cereal::make_nvp("# empty", s.empty)
          , cereal::make_nvp("# buckets", s.buckets)
+         , cereal::make_nvp("# dead", s.dead)
+         , cereal::make_nvp("# resurrected", s.resurrected)
+         , cereal::make_nvp("# collected", s.collected)
          , cereal::make_nvp("load factor", s.load_factor));
 }
 
@@ -73,6 +76,7 @@ save(Archive& archive, const manager_statistics<C>& m)
 {
   archive( cereal::make_nvp("SDD unique table", m.sdd_ut())
          , cereal::make_nvp("SDD differences cache", m.diff_cache())
+         , cereal::make_nvp("SDD differences-sums cache", m.diff_sum_cache())
          , cereal::make_nvp("SDD intersections cache", m.inter_cache())
          , cereal::make_nvp("SDD sums cache", m.sum_cache())
          , cereal::make_nvp("hom unique table", m.hom_ut())
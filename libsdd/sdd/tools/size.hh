@@ -60,7 +60,7 @@ struct size_visitor
     if (visited_.emplace(&n).second)
     {
       std::size_t res = sizeof(typename SDD<C>::unique_type) // size of a ref_counted
-                      + n.size() * sizeof(typename flat_node<C>::arc_type); // arcs
+                      + flat_node<C>::alpha_layout::size_to_allocate(n.size()); // arcs
       for (const auto& arc : n)
       {
         res += visit(*this, arc.successor());
@@ -80,7 +80,7 @@ struct size_visitor
     if (visited_.emplace(&n).second)
     {
       std::size_t res = sizeof(typename SDD<C>::unique_type) // size of a ref_counted
-                      + n.size() * sizeof(typename hierarchical_node<C>::arc_type); // arcs
+                      + hierarchical_node<C>::alpha_layout::size_to_allocate(n.size()); // arcs
       for (const auto& arc : n)
       {
         res += visit(*this, arc.valuation());
@@ -16,9 +16,22 @@ namespace sdd { namespace hash {
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @brief Combine an already computed hash value with seed.
+///
+/// Taken from <boost/functional/hash.hpp>.
+inline
+void
+combine_value(std::size_t& seed, std::size_t hash)
+noexcept
+{
+  seed ^= hash + 0x9e3779b9 + (seed<<6) + (seed>>2);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @brief Combine the hash value of x with seed.
 ///
-/// Taken from <boost/functional/hash.hpp>. Sligthy modified to use std::hash<T> instead of
+/// Sligthy modified from <boost/functional/hash.hpp> to use std::hash<T> instead of
 /// boost::hash_value().
 template <typename T>
 inline
@@ -26,7 +39,7 @@ void
 hash_combine(std::size_t& seed, const T& x)
 noexcept(noexcept(std::hash<T>()(x)))
 {
-  seed ^= std::hash<T>()(x) + 0x9e3779b9 + (seed<<6) + (seed>>2);
+  combine_value(seed, std::hash<T>()(x));
 }
 
 /*------------------------------------------------------------------------------------------------*/
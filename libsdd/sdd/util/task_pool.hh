@@ -0,0 +1,305 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>   // exception_ptr
+#include <memory>      // unique_ptr
+#include <mutex>
+#include <thread>
+#include <type_traits> // remove_reference
+#include <utility>     // pair
+#include <vector>
+
+namespace sdd { namespace util {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A pool of threads which evaluate fork-join tasks with work-stealing.
+///
+/// Each worker owns a double-ended queue of tasks: it pushes and pops tasks at the back, while
+/// idle workers steal tasks at the front. The thread which calls parallel_for() is not a thread of
+/// the pool, it acts as worker 0. A worker waiting for the tasks it forked doesn't block: it
+/// evaluates its own tasks or steals some from others in the meantime. Thus, tasks are always
+/// nested in the stack of the thread which evaluates them, which is necessary to use stack-like
+/// allocators (like mem::arena) for each worker.
+///
+/// Only one thread which is not part of the pool should call parallel_for() at a given time.
+class task_pool
+{
+  // Can't copy a task_pool.
+  task_pool(const task_pool&) = delete;
+  task_pool& operator=(const task_pool&) = delete;
+
+private:
+
+  /// @brief A set of tasks forked by the same call to parallel_for().
+  struct group
+  {
+    /// @brief The number of tasks not yet evaluated.
+    std::atomic<std::size_t> pending;
+
+    /// @brief Protect error.
+    std::mutex mutex;
+
+    /// @brief The first exception raised by a task of this group.
+    std::exception_ptr error;
+
+    group(std::size_t nb_tasks)
+      : pending(nb_tasks), mutex(), error()
+    {}
+  };
+
+  /// @brief A task: the evaluation of a function for one index.
+  struct task
+  {
+    /// @brief Call the function with a worker and an index.
+    void (*invoke)(void*, std::size_t, std::size_t);
+
+    /// @brief The function, which lives in the stack of the thread that forked this task.
+    void* function;
+
+    /// @brief The index given to the function.
+    std::size_t index;
+
+    /// @brief The set of tasks this task belongs to.
+    group* owner;
+  };
+
+  /// @brief The tasks of a worker.
+  struct queue
+  {
+    std::mutex mutex;
+    std::deque<task> tasks;
+  };
+
+  /// @brief One queue per worker, including worker 0.
+  std::vector<std::unique_ptr<queue>> queues_;
+
+  /// @brief The threads of workers 1 to n-1.
+  std::vector<std::thread> threads_;
+
+  /// @brief The number of tasks waiting in all queues.
+  std::atomic<std::size_t> queued_;
+
+  /// @brief Tell workers to stop.
+  std::atomic<bool> stop_;
+
+  /// @brief Used by idle workers to wait for tasks.
+  std::mutex sleep_mutex_;
+
+  /// @brief Used by idle workers to wait for tasks.
+  std::condition_variable sleep_cv_;
+
+public:
+
+  /// @brief Constructor.
+  /// @param nb_workers The number of workers, including the thread which will fork tasks.
+  task_pool(std::size_t nb_workers)
+    : queues_(), threads_(), queued_(0), stop_(false), sleep_mutex_(), sleep_cv_()
+  {
+    nb_workers = nb_workers == 0 ? 1 : nb_workers;
+    queues_.reserve(nb_workers);
+    for (std::size_t i = 0; i < nb_workers; ++i)
+    {
+      queues_.emplace_back(std::make_unique<queue>());
+    }
+    threads_.reserve(nb_workers - 1);
+    for (std::size_t i = 1; i < nb_workers; ++i)
+    {
+      threads_.emplace_back([this, i]{work(i);});
+    }
+  }
+
+  /// @brief Destructor.
+  ///
+  /// Wait for all workers to finish.
+  ~task_pool()
+  {
+    stop_ = true;
+    sleep_cv_.notify_all();
+    for (auto& thread : threads_)
+    {
+      thread.join();
+    }
+  }
+
+  /// @brief Get the number of workers, including worker 0.
+  std::size_t
+  size()
+  const noexcept
+  {
+    return queues_.size();
+  }
+
+  /// @brief Evaluate f(worker, i) for each i in [0, nb_tasks), in parallel.
+  ///
+  /// Return when all tasks are evaluated. If tasks raise exceptions, the first one is rethrown.
+  template <typename Function>
+  void
+  parallel_for(std::size_t nb_tasks, Function&& f)
+  {
+    if (nb_tasks == 0)
+    {
+      return;
+    }
+
+    const auto self = worker_index();
+    group g(nb_tasks);
+    auto invoke = [](void* fun, std::size_t worker, std::size_t i)
+                  {
+                    (*static_cast<std::remove_reference_t<Function>*>(fun))(worker, i);
+                  };
+    void* fun = const_cast<void*>(static_cast<const void*>(&f));
+
+    // Push in reverse order, the owner pops the next index from the back.
+    {
+      auto& q = *queues_[self];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      for (std::size_t i = nb_tasks - 1; i > 0; --i)
+      {
+        q.tasks.push_back(task{invoke, fun, i, &g});
+      }
+    }
+    queued_ += nb_tasks - 1;
+    sleep_cv_.notify_all();
+
+    // The first task is evaluated right away.
+    run(task{invoke, fun, 0, &g}, self);
+
+    // Help other workers while our tasks are not finished.
+    while (g.pending.load(std::memory_order_acquire) != 0)
+    {
+      task t;
+      if (pop(self, t) or steal(self, t))
+      {
+        run(t, self);
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    if (g.error)
+    {
+      std::rethrow_exception(g.error);
+    }
+  }
+
+private:
+
+  /// @brief The index of the worker of the calling thread.
+  ///
+  /// Threads which are not part of this pool are considered as worker 0.
+  std::size_t
+  worker_index()
+  const noexcept
+  {
+    return current().first == this ? current().second : 0;
+  }
+
+  /// @brief Store the pool and the worker index of the calling thread.
+  static
+  std::pair<const task_pool*, std::size_t>&
+  current()
+  noexcept
+  {
+    static thread_local std::pair<const task_pool*, std::size_t> c{nullptr, 0};
+    return c;
+  }
+
+  /// @brief The loop of workers 1 to n-1.
+  void
+  work(std::size_t self)
+  {
+    current() = {this, self};
+    while (not stop_)
+    {
+      task t;
+      if (pop(self, t) or steal(self, t))
+      {
+        run(t, self);
+      }
+      else
+      {
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait_for( lock, std::chrono::milliseconds(1)
+                          , [this]{return stop_ or queued_ != 0;});
+      }
+    }
+  }
+
+  /// @brief Evaluate a task and signal its group.
+  static
+  void
+  run(const task& t, std::size_t worker)
+  noexcept
+  {
+    try
+    {
+      t.invoke(t.function, worker, t.index);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(t.owner->mutex);
+      if (not t.owner->error)
+      {
+        t.owner->error = std::current_exception();
+      }
+    }
+    // The group might be destroyed as soon as pending reaches 0, don't use it afterwards.
+    t.owner->pending.fetch_sub(1, std::memory_order_release);
+  }
+
+  /// @brief Take the most recently pushed task of a worker's own queue.
+  bool
+  pop(std::size_t self, task& t)
+  {
+    auto& q = *queues_[self];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.tasks.empty())
+    {
+      return false;
+    }
+    t = q.tasks.back();
+    q.tasks.pop_back();
+    --queued_;
+    return true;
+  }
+
+  /// @brief Take the oldest task of another worker's queue.
+  bool
+  steal(std::size_t self, task& t)
+  {
+    if (queued_ == 0)
+    {
+      return false;
+    }
+    for (std::size_t i = 1; i < queues_.size(); ++i)
+    {
+      auto& q = *queues_[(self + i) % queues_.size()];
+      std::lock_guard<std::mutex> lock(q.mutex);
+      if (not q.tasks.empty())
+      {
+        t = q.tasks.front();
+        q.tasks.pop_front();
+        --queued_;
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::util
@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <cstddef>     // size_t
+#include <type_traits> // integral_constant
+
 namespace sdd { namespace util {
 
 /*------------------------------------------------------------------------------------------------*/
@@ -59,6 +62,31 @@ struct list {};
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Tell if a type belongs to a list.
+template <typename T, typename List>
+struct contains;
+
+/// @internal
+template <typename T>
+struct contains<T, list<>>
+  : std::false_type
+{};
+
+/// @internal
+template <typename T, typename... Xs>
+struct contains<T, list<T, Xs...>>
+  : std::true_type
+{};
+
+/// @internal
+template <typename T, typename X, typename... Xs>
+struct contains<T, list<X, Xs...>>
+  : contains<T, list<Xs...>>
+{};
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 template <typename X, typename... Ys>
 using mul = list<pair<X, Ys>...>;
@@ -20,6 +20,8 @@ namespace sdd { namespace values {
 /*------------------------------------------------------------------------------------------------*/
 
 /// @brief Encode a set of values using bits.
+///
+/// Size can't exceed 64, wide_bitset and dynamic_bitset handle larger domains.
 template <std::size_t Size>
 class bitset final
 {
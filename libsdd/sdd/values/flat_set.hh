@@ -6,17 +6,21 @@
 
 #pragma once
 
-#include <algorithm>   // copy, set_difference, set_intersection, set_union
+#include <algorithm>   // copy, lower_bound, set_difference, set_intersection, set_union
+#include <cassert>
+#include <cstdint>     // uintptr_t
+#include <cstring>     // memcpy, memset
 #include <functional>  // hash
 #include <initializer_list>
 #include <iosfwd>
-#include <iterator>    // inserter
+#include <iterator>    // inserter, reverse_iterator
 #include <type_traits> // enable_if, is_integral
 #include <utility>     // pair
 
 #include <boost/container/flat_set.hpp>
 
 #include "sdd/values_manager_fwd.hh"
+#include "sdd/mem/cache.hh"
 #include "sdd/mem/ptr.hh"
 #include "sdd/mem/unique.hh"
 #include "sdd/util/hash.hh"
@@ -27,6 +31,9 @@ namespace sdd { namespace values {
 /*------------------------------------------------------------------------------------------------*/
 
 /// @brief A unified set of values, implemented with a sorted vector.
+///
+/// Sets which are small enough are stored inline, in place of the pointer to the unified data.
+/// They don't go through the unique table, and their operations are not cached.
 template <typename Value>
 class flat_set final
 {
@@ -42,38 +49,102 @@ public:
   /// @internal
   using unique_type = mem::unique<data_type>;
 
-  /// @internal
-  using ptr_type = mem::ptr<unique_type>;
+  /// @brief The type to modify a set of values in bulk, before building a new flat_set.
+  using builder_type = data_type;
 
   /// @brief The type of an iterator on a flat set of values.
-  using const_iterator = typename data_type::const_iterator;
+  using const_iterator = const Value*;
 
   /// @brief The type of an reverse iterator on a flat set of values.
-  using const_reverse_iterator = typename data_type::const_reverse_iterator;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  /// @brief The maximal number of values stored inline.
+  ///
+  /// Only integral values are stored inline, as equality and hash are then computed on the bytes
+  /// of the storage.
+  static constexpr std::size_t inline_capacity
+    = std::is_integral<Value>::value
+    ? (sizeof(unique_type*) - alignof(Value)) / sizeof(Value)
+    : 0;
 
 private:
 
-  /// @brief A pointer to the unified set of values.
-  ptr_type ptr_;
+  /// @brief The index of the byte which tells if values are inline.
+  ///
+  /// It's the byte of the lowest bit of a pointer, which is always 0 for an aligned pointer. For
+  /// inline values, it's set to 1, and the following bits store the number of values.
+  static constexpr std::size_t tag_index
+    = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ ? 0 : sizeof(unique_type*) - 1;
 
-public:
+  /// @brief The offset of inline values in the storage.
+  static constexpr std::size_t values_offset
+    = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ ? alignof(Value) : 0;
 
-  /// @brief Default copy constructor.
-  flat_set(const flat_set&) = default;
+  /// @brief Either a pointer to the unified set of values, or inline values.
+  alignas(unique_type*) unsigned char storage_[sizeof(unique_type*)];
 
-  /// @brief Default copy operator.
-  flat_set& operator=(const flat_set&) = default;
+public:
 
   /// @brief Default constructor.
   flat_set()
-    : ptr_(empty_set())
-  {}
+  noexcept
+  {
+    set_empty();
+  }
+
+  /// @brief Copy constructor.
+  flat_set(const flat_set& other)
+  noexcept
+  {
+    std::memcpy(storage_, other.storage_, sizeof(storage_));
+    if (unified())
+    {
+      unique()->increment_reference_counter();
+    }
+  }
+
+  /// @brief Copy operator.
+  flat_set&
+  operator=(const flat_set& other)
+  noexcept
+  {
+    flat_set tmp(other);
+    swap(tmp);
+    return *this;
+  }
+
+  /// @brief Move constructor.
+  flat_set(flat_set&& other)
+  noexcept
+  {
+    std::memcpy(storage_, other.storage_, sizeof(storage_));
+    other.set_empty();
+  }
+
+  /// @brief Move operator.
+  flat_set&
+  operator=(flat_set&& other)
+  noexcept
+  {
+    swap(other);
+    return *this;
+  }
+
+  /// @brief Destructor.
+  ~flat_set()
+  {
+    if (unified() and unique()->decrement_reference_counter())
+    {
+      mem::table_deleter<mem::unique_table<unique_type>>::erase(unique());
+    }
+  }
 
   /// @brief Constructor with a range.
   template <typename InputIterator>
   flat_set(InputIterator begin, InputIterator end)
-    : ptr_(create(begin, end))
-  {}
+  {
+    init(data_type(begin, end));
+  }
 
   /// @brief Constructor with a initializer_list.
   flat_set(std::initializer_list<Value> values)
@@ -82,21 +153,47 @@ public:
 
   /// @brief Constructor from a temporary data_type.
   flat_set(data_type&& fs)
-    : ptr_(create(std::move(fs)))
-  {}
+  {
+    init(std::move(fs));
+  }
 
   /// @brief Insert a value.
   std::pair<const_iterator, bool>
   insert(const Value& x)
   {
-    data_type fs(ptr_->data());
-    const auto insertion = fs.insert(x);
-    if (insertion.second)
+    const auto search = lower_bound(x);
+    if (search != end() and not (x < *search))
     {
-      fs.shrink_to_fit();
-      ptr_ = create(std::move(fs));
+      return {search, false};
     }
-    return insertion;
+    data_type fs(boost::container::ordered_unique_range, begin(), end());
+    fs.insert(x);
+    *this = flat_set(std::move(fs));
+    return {find(x), true};
+  }
+
+  /// @brief Insert a range of values, with a single unification.
+  template <typename InputIterator>
+  void
+  insert(InputIterator first, InputIterator last)
+  {
+    data_type fs(boost::container::ordered_unique_range, begin(), end());
+    fs.insert(first, last);
+    if (fs.size() != size())
+    {
+      *this = flat_set(std::move(fs));
+    }
+  }
+
+  /// @brief Get a copy of the values, to modify them in bulk.
+  ///
+  /// A flat_set constructed from the modified builder is unified once, whereas successive calls
+  /// to insert() or erase() unify each intermediary set.
+  builder_type
+  builder()
+  const
+  {
+    return builder_type(boost::container::ordered_unique_range, begin(), end());
   }
 
   /// @brief Returns an iterator pointing to the first element in the flat set.
@@ -104,7 +201,7 @@ public:
   begin()
   const noexcept
   {
-    return ptr_->data().cbegin();
+    return unified() ? &*unique()->data().cbegin() : inline_values();
   }
 
   /// @brief Returns an iterator pointing to the last element in the flat set.
@@ -112,7 +209,7 @@ public:
   end()
   const noexcept
   {
-    return ptr_->data().cend();
+    return begin() + size();
   }
 
   /// @brief Returns an iterator pointing to the first element in the flat set.
@@ -120,7 +217,7 @@ public:
   cbegin()
   const noexcept
   {
-    return ptr_->data().cbegin();
+    return begin();
   }
 
   /// @brief Returns an iterator pointing to the last element in the flat set.
@@ -128,7 +225,7 @@ public:
   cend()
   const noexcept
   {
-    return ptr_->data().cend();
+    return end();
   }
 
   /// @brief Returns a reverse iterator pointing to the last element in the flat set.
@@ -136,7 +233,7 @@ public:
   rbegin()
   const noexcept
   {
-    return ptr_->data().crbegin();
+    return const_reverse_iterator(end());
   }
 
   /// @brief Returns a reverse iterator pointing to the first element in the flat set.
@@ -144,7 +241,7 @@ public:
   rend()
   const noexcept
   {
-    return ptr_->data().crend();
+    return const_reverse_iterator(begin());
   }
 
   /// @brief Returns a reverse iterator pointing to the first element in the flat set.
@@ -152,7 +249,7 @@ public:
   crbegin()
   const noexcept
   {
-    return ptr_->data().crbegin();
+    return rbegin();
   }
 
   /// @brief Returns a reverse iterator pointing to the last element in the flat set.
@@ -160,7 +257,7 @@ public:
   crend()
   const noexcept
   {
-    return ptr_->data().crend();
+    return rend();
   }
 
   /// @brief Tell if this set of values is empty.
@@ -168,7 +265,7 @@ public:
   empty()
   const noexcept
   {
-    return ptr_->data().empty();
+    return size() == 0;
   }
 
   /// @brief Get the number of contained values.
@@ -176,7 +273,7 @@ public:
   size()
   const noexcept
   {
-    return ptr_->data().size();
+    return unified() ? unique()->data().size() : storage_[tag_index] >> 1;
   }
 
   /// @brief Find a value.
@@ -184,7 +281,8 @@ public:
   find(const Value& x)
   const
   {
-    return ptr_->data().find(x);
+    const auto search = lower_bound(x);
+    return search != end() and not (x < *search) ? search : end();
   }
 
 
@@ -193,17 +291,21 @@ public:
   count(const Value& x)
   const noexcept
   {
-    return ptr_->data().count(x);
+    return find(x) != end() ? 1 : 0;
   }
 
   /// @brief Erase a value.
   std::size_t
   erase(const Value& x)
   {
-    data_type d(ptr_->data());
-    const std::size_t nb_erased = d.erase(x);
-    ptr_ = create(std::move(d));
-    return nb_erased;
+    if (find(x) == end())
+    {
+      return 0;
+    }
+    data_type d(boost::container::ordered_unique_range, begin(), end());
+    d.erase(x);
+    *this = flat_set(std::move(d));
+    return 1;
   }
 
   /// @brief
@@ -211,7 +313,7 @@ public:
   lower_bound(const Value& x)
   const
   {
-    return ptr_->data().lower_bound(x);
+    return std::lower_bound(begin(), end(), x);
   }
 
   /// @brief
@@ -219,24 +321,38 @@ public:
   upper_bound(const Value& x)
   const
   {
-    return ptr_->data().upper_bound(x);
+    return std::upper_bound(begin(), end(), x);
   }
 
   /// @internal
-  /// @brief Get the pointer to the unified data.
-  ptr_type
-  ptr()
+  /// @brief Tell if values are stored in the unique table rather than inline.
+  bool
+  unified()
   const noexcept
   {
-    return ptr_;
+    return (storage_[tag_index] & 1) == 0;
   }
 
   /// @internal
-  static
-  ptr_type
-  empty_set()
+  /// @brief Get the storage as a single word, a pointer or inline values.
+  std::uintptr_t
+  word()
+  const noexcept
   {
-    return global_values<flat_set<Value>>().state.empty;
+    std::uintptr_t res;
+    std::memcpy(&res, storage_, sizeof(res));
+    return res;
+  }
+
+  /// @brief Swap.
+  void
+  swap(flat_set& other)
+  noexcept
+  {
+    unsigned char tmp[sizeof(storage_)];
+    std::memcpy(tmp, storage_, sizeof(storage_));
+    std::memcpy(storage_, other.storage_, sizeof(storage_));
+    std::memcpy(other.storage_, tmp, sizeof(storage_));
   }
 
   /// @brief Equality.
@@ -247,8 +363,8 @@ public:
   operator==(const flat_set<Value>& lhs, const flat_set<Value>& rhs)
   noexcept
   {
-    // Pointer equality.
-    return lhs.ptr() == rhs.ptr();
+    // Pointer or inline values equality, as a set is stored inline only if it's small enough.
+    return lhs.word() == rhs.word();
   }
 
   /// @brief Inequality.
@@ -259,8 +375,7 @@ public:
   operator!=(const flat_set<Value>& lhs, const flat_set<Value>& rhs)
   noexcept
   {
-    // Pointer inequality.
-    return not(lhs.ptr() == rhs.ptr());
+    return not(lhs == rhs);
   }
 
   /// @brief Less than comparison.
@@ -271,40 +386,60 @@ public:
   operator<(const flat_set<Value>& lhs, const flat_set<Value>& rhs)
   noexcept
   {
-    // Pointer comparison.
-    return lhs.ptr() < rhs.ptr();
+    return lhs.word() < rhs.word();
   }
 
 private:
 
-  /// @brief Create a smart pointer to unified set of values, from a pair of iterators.
-  template <typename InputIterator>
-  static
-  ptr_type
-  create(InputIterator begin, InputIterator end)
+  /// @brief Get the unified set of values.
+  unique_type*
+  unique()
+  const noexcept
   {
-    if (begin == end)
-    {
-      return empty_set();
-    }
-    else
-    {
-      return ptr_type(&unify(data_type(begin, end)));
-    }
+    assert(unified());
+    unique_type* res;
+    std::memcpy(&res, storage_, sizeof(res));
+    return res;
   }
 
-  /// @brief Create a smart pointer to a unified set of values, from a boost::container::flat_set.
-  static
-  ptr_type
-  create(data_type&& x)
+  /// @brief Get the values stored inline.
+  const Value*
+  inline_values()
+  const noexcept
+  {
+    return reinterpret_cast<const Value*>(storage_ + values_offset);
+  }
+
+  /// @brief Store the empty set inline.
+  void
+  set_empty()
+  noexcept
+  {
+    std::memset(storage_, 0, sizeof(storage_));
+    storage_[tag_index] = 1;
+  }
+
+  /// @brief Store values inline if there are few of them, unify them otherwise.
+  void
+  init(data_type&& x)
   {
-    if (x.empty())
+    if (x.size() <= inline_capacity)
     {
-      return empty_set();
+      set_empty();
+      storage_[tag_index] = static_cast<unsigned char>(1 | (x.size() << 1));
+      std::size_t i = 0;
+      for (const auto& v : x)
+      {
+        new (storage_ + values_offset + sizeof(Value) * i++) Value(v);
+      }
     }
     else
     {
-      return ptr_type(&unify(std::move(x)));
+      x.shrink_to_fit();
+      unique_type* u = &unify(std::move(x));
+      assert((reinterpret_cast<std::uintptr_t>(u) & 1) == 0 && "Unaligned unified data");
+      u->increment_reference_counter();
+      std::memcpy(storage_, &u, sizeof(storage_));
     }
   }
 
@@ -322,6 +457,86 @@ private:
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief The context of the cache of flat_set operations, which doesn't need any state.
+struct flat_set_cache_context {};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief A binary operation on flat_set.
+///
+/// Operations on unified sets are cached by flat_set_manager.
+template <typename Value>
+struct flat_set_operation
+{
+  /// @brief The kind of the operation.
+  enum class kind : unsigned char {sum, intersection, difference};
+
+  const kind op;
+  const flat_set<Value> lhs;
+  const flat_set<Value> rhs;
+
+  /// @brief Evaluate the operation.
+  flat_set<Value>
+  operator()(flat_set_cache_context&)
+  const
+  {
+    typename flat_set<Value>::data_type res;
+    switch (op)
+    {
+      case kind::sum:
+        res.reserve(lhs.size() + rhs.size());
+        std::set_union( lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend()
+                      , std::inserter(res, res.end()));
+        break;
+
+      case kind::intersection:
+        std::set_intersection( lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend()
+                             , std::inserter(res, res.end()));
+        break;
+
+      case kind::difference:
+        std::set_difference( lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend()
+                           , std::inserter(res, res.end()));
+        break;
+    }
+    return {std::move(res)};
+  }
+
+  friend
+  bool
+  operator==(const flat_set_operation& l, const flat_set_operation& r)
+  noexcept
+  {
+    return l.op == r.op and l.lhs == r.lhs and l.rhs == r.rhs;
+  }
+};
+
+}} // namespace sdd::values
+
+namespace std {
+
+/// @internal
+/// @brief Hash specialization for sdd::values::flat_set_operation
+template <typename Value>
+struct hash<sdd::values::flat_set_operation<Value>>
+{
+  std::size_t
+  operator()(const sdd::values::flat_set_operation<Value>& x)
+  const noexcept
+  {
+    using namespace sdd::hash;
+    return seed(static_cast<unsigned char>(x.op)) (val(x.lhs.word())) (val(x.rhs.word()));
+  }
+};
+
+} // namespace std
+
+namespace sdd { namespace values {
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @internal
 /// @brief Will be used by sdd::manager.
 template <typename Value>
@@ -330,38 +545,41 @@ struct flat_set_manager
   /// @brief The type of a unified flat_set.
   using unique_type = typename flat_set<Value>::unique_type;
 
-  /// @brief The type of smart pointer to a unified flat_set.
-  using ptr_type = typename flat_set<Value>::ptr_type;
-
   /// @brief The type of this manager's statistics.
   using statistics_type = mem::unique_table_statistics;
 
-  /// @brief Manage the handler needed by ptr when a unified data is no longer referenced.
+  /// @brief Manage the handler needed by flat_set when a unified data is no longer referenced.
   struct ptr_handler
   {
     ptr_handler(mem::unique_table<unique_type>& ut)
     {
-      mem::set_deletion_handler<unique_type>([&](const unique_type* u){ut.erase(u);});
+      mem::set_deletion_table(ut);
     }
 
     ~ptr_handler()
     {
-      mem::reset_deletion_handler<unique_type>();
+      mem::reset_deletion_table<mem::unique_table<unique_type>>();
     }
   } handler;
 
   /// @brief The set of unified flat_set.
   mem::unique_table<unique_type> unique_table;
 
-  /// @brief The cached empty flat_set.
-  const ptr_type empty;
+  /// @brief The context of the cache of operations.
+  flat_set_cache_context cache_context;
+
+  /// @brief The cache of operations on unified flat_set.
+  ///
+  /// Declared after the unique table, as its entries must be destroyed first.
+  mem::cache<flat_set_cache_context, flat_set_operation<Value>> cache;
 
   /// @brief Constructor.
   template <typename C>
   flat_set_manager(const C& configuration)
     : handler(unique_table)
     , unique_table(configuration.flat_set_unique_table_size)
-    , empty(mk_empty())
+    , cache_context()
+    , cache(cache_context, configuration.flat_set_cache_size)
   {}
 
   const statistics_type&
@@ -371,15 +589,12 @@ struct flat_set_manager
     return unique_table.stats();
   }
 
-private:
-
-  /// @brief Helper to construct the empty flat_set.
-  ptr_type
-  mk_empty()
+  /// @brief Get the statistics of the cache of operations.
+  const mem::cache_statistics&
+  operations_statistics()
+  const noexcept
   {
-    char* addr = unique_table.allocate(0 /*extra bytes*/);
-    unique_type* u = new (addr) unique_type;
-    return ptr_type(&unique_table(u, 0));
+    return cache.statistics();
   }
 };
 
@@ -395,7 +610,7 @@ struct values_traits<flat_set<Value>>
   static constexpr bool stateful = true;
   static constexpr bool fast_iterable = true;
   using state_type = flat_set_manager<Value>;
-  using builder = boost::container::flat_set<Value>;
+  using builder = typename flat_set<Value>::builder_type;
 };
 
 /*------------------------------------------------------------------------------------------------*/
@@ -471,6 +686,27 @@ operator<<(std::ostream& os, const flat_set<Value>& fs)
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @internal
+/// @brief Evaluate an operation, with the cache if an operand is unified.
+/// @related flat_set
+template <typename Value>
+inline
+flat_set<Value>
+apply_operation(flat_set_operation<Value>&& op)
+{
+  if (op.lhs.unified() or op.rhs.unified())
+  {
+    return global_values<flat_set<Value>>().state.cache(std::move(op));
+  }
+  else
+  {
+    flat_set_cache_context cxt;
+    return op(cxt);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 /// @related flat_set
 template <typename Value>
 inline
@@ -478,10 +714,16 @@ flat_set<Value>
 difference(const flat_set<Value>& lhs, const flat_set<Value>& rhs)
 noexcept
 {
-  typename flat_set<Value>::data_type res;
-  std::set_difference( lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend()
-                     , std::inserter(res, res.begin()));
-  return {std::move(res)};
+  if (lhs == rhs or lhs.empty())
+  {
+    return {};
+  }
+  if (rhs.empty())
+  {
+    return lhs;
+  }
+  using kind = typename flat_set_operation<Value>::kind;
+  return apply_operation(flat_set_operation<Value>{kind::difference, lhs, rhs});
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -493,10 +735,19 @@ flat_set<Value>
 intersection(const flat_set<Value>& lhs, const flat_set<Value>& rhs)
 noexcept
 {
-  typename flat_set<Value>::data_type res;
-  std::set_intersection( lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend()
-                       , std::inserter(res, res.begin()));
-  return {std::move(res)};
+  if (lhs == rhs)
+  {
+    return lhs;
+  }
+  if (lhs.empty() or rhs.empty())
+  {
+    return {};
+  }
+  using kind = typename flat_set_operation<Value>::kind;
+  // The intersection is commutative, operands are ordered to share cache entries.
+  return rhs < lhs
+       ? apply_operation(flat_set_operation<Value>{kind::intersection, rhs, lhs})
+       : apply_operation(flat_set_operation<Value>{kind::intersection, lhs, rhs});
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -508,10 +759,19 @@ flat_set<Value>
 sum(const flat_set<Value>& lhs, const flat_set<Value>& rhs)
 noexcept
 {
-  typename flat_set<Value>::data_type res;
-  std::set_union( lhs.cbegin(), lhs.cend(), rhs.cbegin(), rhs.cend()
-                , std::inserter(res, res.begin()));
-  return {std::move(res)};
+  if (lhs == rhs or rhs.empty())
+  {
+    return lhs;
+  }
+  if (lhs.empty())
+  {
+    return rhs;
+  }
+  using kind = typename flat_set_operation<Value>::kind;
+  // The sum is commutative, operands are ordered to share cache entries.
+  return rhs < lhs
+       ? apply_operation(flat_set_operation<Value>{kind::sum, rhs, lhs})
+       : apply_operation(flat_set_operation<Value>{kind::sum, lhs, rhs});
 }
 
 /*------------------------------------------------------------------------------------------------*/
@@ -545,7 +805,7 @@ struct hash<sdd::values::flat_set<Value>>
   operator()(const sdd::values::flat_set<Value>& fs)
   const noexcept
   {
-    return sdd::hash::seed(fs.ptr());
+    return sdd::hash::seed(fs.word());
   }
 };
 
@@ -0,0 +1,582 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm>   // lower_bound, max, min, sort, unique
+#include <cstdint>     // intmax_t
+#include <functional>  // hash
+#include <initializer_list>
+#include <iosfwd>
+#include <iterator>    // forward_iterator_tag
+#include <limits>
+#include <type_traits> // is_integral
+#include <utility>     // pair
+#include <vector>
+
+#include "sdd/util/hash.hh"
+
+namespace sdd { namespace values {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief A set of integral values stored as a sorted list of disjoint closed intervals.
+///
+/// It suits variables which hold contiguous ranges of values, like clocks or bounded counters:
+/// operations are linear in the number of intervals rather than in the number of values.
+/// Intervals are never adjacent, thus two equal sets have the same intervals.
+template <typename Value>
+class interval_set final
+{
+  static_assert(std::is_integral<Value>::value, "interval_set requires integral values");
+
+public:
+
+  /// @brief The type of the contained value.
+  using value_type = Value;
+
+  /// @brief The closed interval [first, second].
+  using interval_type = std::pair<Value, Value>;
+
+  /// @brief Iterate on values, in increasing order.
+  class const_iterator
+  {
+  public:
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = Value;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const Value*;
+    using reference         = Value;
+
+  private:
+
+    typename std::vector<interval_type>::const_iterator interval_;
+    typename std::vector<interval_type>::const_iterator end_;
+    Value value_;
+
+  public:
+
+    const_iterator( typename std::vector<interval_type>::const_iterator interval
+                  , typename std::vector<interval_type>::const_iterator end)
+    noexcept
+      : interval_(interval), end_(end), value_(interval != end ? interval->first : Value())
+    {}
+
+    Value
+    operator*()
+    const noexcept
+    {
+      return value_;
+    }
+
+    const_iterator&
+    operator++()
+    noexcept
+    {
+      if (value_ == interval_->second)
+      {
+        ++interval_;
+        value_ = interval_ != end_ ? interval_->first : Value();
+      }
+      else
+      {
+        ++value_;
+      }
+      return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    noexcept
+    {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend
+    bool
+    operator==(const const_iterator& lhs, const const_iterator& rhs)
+    noexcept
+    {
+      return lhs.interval_ == rhs.interval_ and lhs.value_ == rhs.value_;
+    }
+
+    friend
+    bool
+    operator!=(const const_iterator& lhs, const const_iterator& rhs)
+    noexcept
+    {
+      return not (lhs == rhs);
+    }
+  };
+
+private:
+
+  /// @brief Sorted, disjoint and not adjacent intervals.
+  std::vector<interval_type> intervals_;
+
+  /// @brief The number of values, to answer size() in O(1).
+  std::size_t size_;
+
+public:
+
+  /// @brief Default constructor.
+  interval_set()
+    : intervals_(), size_(0)
+  {}
+
+  /// @brief Constructor with a range of values, in any order.
+  template <typename InputIterator>
+  interval_set(InputIterator begin, InputIterator end)
+    : interval_set()
+  {
+    std::vector<Value> values(begin, end);
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    for (const auto v : values)
+    {
+      append(intervals_, interval_type(v, v));
+    }
+    compute_size();
+  }
+
+  /// @brief Constructor with a list of values.
+  interval_set(std::initializer_list<Value> values)
+    : interval_set(values.begin(), values.end())
+  {}
+
+  /// @brief Constructor with a list of intervals, in any order.
+  ///
+  /// Overlapping and adjacent intervals are merged.
+  interval_set(std::initializer_list<interval_type> intervals)
+    : interval_set()
+  {
+    std::vector<interval_type> tmp(intervals);
+    std::sort(tmp.begin(), tmp.end());
+    for (const auto& i : tmp)
+    {
+      if (i.first <= i.second)
+      {
+        append(intervals_, i);
+      }
+    }
+    compute_size();
+  }
+
+  /// @internal
+  /// @brief Constructor with intervals which are already sorted, disjoint and not adjacent.
+  interval_set(std::vector<interval_type>&& intervals)
+    : intervals_(std::move(intervals)), size_(0)
+  {
+    compute_size();
+  }
+
+  /// @brief Insert a value.
+  void
+  insert(Value x)
+  {
+    if (not contains(x))
+    {
+      *this = sum(*this, interval_set(std::vector<interval_type>{interval_type(x, x)}));
+    }
+  }
+
+  /// @brief Tell if a value is in this set.
+  ///
+  /// O(log(#intervals)).
+  bool
+  contains(Value x)
+  const noexcept
+  {
+    const auto search = std::lower_bound( intervals_.begin(), intervals_.end(), x
+                                        , [](const interval_type& i, Value v)
+                                            {return i.second < v;});
+    return search != intervals_.end() and search->first <= x;
+  }
+
+  /// @brief Get the intervals.
+  const std::vector<interval_type>&
+  intervals()
+  const noexcept
+  {
+    return intervals_;
+  }
+
+  const_iterator
+  begin()
+  const noexcept
+  {
+    return {intervals_.begin(), intervals_.end()};
+  }
+
+  const_iterator
+  end()
+  const noexcept
+  {
+    return {intervals_.end(), intervals_.end()};
+  }
+
+  /// @brief Tell if this set of values is empty.
+  bool
+  empty()
+  const noexcept
+  {
+    return intervals_.empty();
+  }
+
+  /// @brief Get the number of contained values.
+  ///
+  /// O(1).
+  std::size_t
+  size()
+  const noexcept
+  {
+    return size_;
+  }
+
+  /// @internal
+  /// @brief Add an interval after all intervals of res, merging it with the last one if needed.
+  ///
+  /// The first value of i must not be lower than the first value of the last interval of res.
+  static
+  void
+  append(std::vector<interval_type>& res, const interval_type& i)
+  {
+    if (res.empty() or (res.back().second != std::numeric_limits<Value>::max()
+                        and res.back().second + 1 < i.first))
+    {
+      res.push_back(i);
+    }
+    else if (res.back().second < i.second)
+    {
+      res.back().second = i.second;
+    }
+  }
+
+  /// @brief Equality.
+  ///
+  /// O(#intervals).
+  friend
+  bool
+  operator==(const interval_set& lhs, const interval_set& rhs)
+  noexcept
+  {
+    return lhs.size_ == rhs.size_ and lhs.intervals_ == rhs.intervals_;
+  }
+
+  /// @brief Inequality.
+  friend
+  bool
+  operator!=(const interval_set& lhs, const interval_set& rhs)
+  noexcept
+  {
+    return not (lhs == rhs);
+  }
+
+  /// @brief Less than comparison.
+  ///
+  /// The order on interval_set is arbitrary.
+  friend
+  bool
+  operator<(const interval_set& lhs, const interval_set& rhs)
+  noexcept
+  {
+    return lhs.intervals_ < rhs.intervals_;
+  }
+
+private:
+
+  void
+  compute_size()
+  noexcept
+  {
+    size_ = 0;
+    for (const auto& i : intervals_)
+    {
+      size_ += static_cast<std::size_t>(i.second - i.first) + 1;
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Textual output of an interval_set.
+///
+/// Intervals are displayed like 1..9.
+/// @related interval_set
+template <typename Value>
+std::ostream&
+operator<<(std::ostream& os, const interval_set<Value>& s)
+{
+  os << "{";
+  for (auto cit = s.intervals().begin(); cit != s.intervals().end(); ++cit)
+  {
+    if (cit != s.intervals().begin())
+    {
+      os << ",";
+    }
+    if (cit->first == cit->second)
+    {
+      os << +cit->first;
+    }
+    else
+    {
+      os << +cit->first << ".." << +cit->second;
+    }
+  }
+  return os << "}";
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @related interval_set
+template <typename Value>
+inline
+interval_set<Value>
+sum(const interval_set<Value>& lhs, const interval_set<Value>& rhs)
+{
+  std::vector<typename interval_set<Value>::interval_type> res;
+  res.reserve(lhs.intervals().size() + rhs.intervals().size());
+  auto lhs_cit = lhs.intervals().begin();
+  auto rhs_cit = rhs.intervals().begin();
+  while (lhs_cit != lhs.intervals().end() or rhs_cit != rhs.intervals().end())
+  {
+    if (rhs_cit == rhs.intervals().end()
+        or (lhs_cit != lhs.intervals().end() and lhs_cit->first < rhs_cit->first))
+    {
+      interval_set<Value>::append(res, *lhs_cit++);
+    }
+    else
+    {
+      interval_set<Value>::append(res, *rhs_cit++);
+    }
+  }
+  return {std::move(res)};
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @related interval_set
+template <typename Value>
+inline
+interval_set<Value>
+intersection(const interval_set<Value>& lhs, const interval_set<Value>& rhs)
+{
+  std::vector<typename interval_set<Value>::interval_type> res;
+  auto lhs_cit = lhs.intervals().begin();
+  auto rhs_cit = rhs.intervals().begin();
+  while (lhs_cit != lhs.intervals().end() and rhs_cit != rhs.intervals().end())
+  {
+    const auto first = std::max(lhs_cit->first, rhs_cit->first);
+    const auto last = std::min(lhs_cit->second, rhs_cit->second);
+    if (first <= last)
+    {
+      res.emplace_back(first, last);
+    }
+    // The interval which ends first can't intersect any other interval.
+    if (lhs_cit->second < rhs_cit->second)
+    {
+      ++lhs_cit;
+    }
+    else
+    {
+      ++rhs_cit;
+    }
+  }
+  return {std::move(res)};
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @related interval_set
+template <typename Value>
+inline
+interval_set<Value>
+difference(const interval_set<Value>& lhs, const interval_set<Value>& rhs)
+{
+  std::vector<typename interval_set<Value>::interval_type> res;
+  auto rhs_cit = rhs.intervals().begin();
+  for (const auto& i : lhs.intervals())
+  {
+    // Skip the intervals of rhs which end before i.
+    while (rhs_cit != rhs.intervals().end() and rhs_cit->second < i.first)
+    {
+      ++rhs_cit;
+    }
+    auto first = i.first;
+    bool remaining = true;
+    for (auto cit = rhs_cit; cit != rhs.intervals().end() and cit->first <= i.second; ++cit)
+    {
+      if (first < cit->first)
+      {
+        res.emplace_back(first, cit->first - 1);
+      }
+      if (cit->second >= i.second)
+      {
+        remaining = false;
+        break;
+      }
+      first = cit->second + 1;
+    }
+    if (remaining)
+    {
+      res.emplace_back(first, i.second);
+    }
+  }
+  return {std::move(res)};
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief A user function for sdd::function() which adds an offset to all values.
+///
+/// Values moved outside of [min, max] are discarded, like for a bounded counter. It's applied in
+/// O(#intervals), whereas a user function would add the offset to each value.
+/// @related interval_set
+template <typename Value>
+class interval_shift
+{
+  static_assert( sizeof(Value) < sizeof(std::intmax_t)
+               , "interval_shift requires values narrower than std::intmax_t");
+
+private:
+
+  /// @brief The offset added to values.
+  const std::intmax_t offset_;
+
+  /// @brief The smallest value that can be obtained.
+  const Value min_;
+
+  /// @brief The greatest value that can be obtained.
+  const Value max_;
+
+public:
+
+  /// @brief Constructor.
+  interval_shift( std::intmax_t offset, Value min = std::numeric_limits<Value>::min()
+                , Value max = std::numeric_limits<Value>::max())
+    : offset_(offset), min_(min), max_(max)
+  {}
+
+  interval_set<Value>
+  operator()(const interval_set<Value>& val)
+  const
+  {
+    // A translation keeps intervals sorted, disjoint and not adjacent.
+    std::vector<typename interval_set<Value>::interval_type> res;
+    res.reserve(val.intervals().size());
+    for (const auto& i : val.intervals())
+    {
+      const auto first = std::max<std::intmax_t>(i.first + offset_, min_);
+      const auto last = std::min<std::intmax_t>(i.second + offset_, max_);
+      if (first <= last)
+      {
+        res.emplace_back(static_cast<Value>(first), static_cast<Value>(last));
+      }
+    }
+    return {std::move(res)};
+  }
+
+  /// @brief Without an offset, values outside of [min, max] are just removed.
+  bool
+  selector()
+  const noexcept
+  {
+    return offset_ == 0;
+  }
+
+  /// @brief Two different values can't be shifted to the same value.
+  bool
+  shifter()
+  const noexcept
+  {
+    return true;
+  }
+
+  std::intmax_t
+  offset()
+  const noexcept
+  {
+    return offset_;
+  }
+
+  Value
+  min()
+  const noexcept
+  {
+    return min_;
+  }
+
+  Value
+  max()
+  const noexcept
+  {
+    return max_;
+  }
+
+  friend
+  bool
+  operator==(const interval_shift& lhs, const interval_shift& rhs)
+  noexcept
+  {
+    return lhs.offset_ == rhs.offset_ and lhs.min_ == rhs.min_ and lhs.max_ == rhs.max_;
+  }
+
+  friend
+  std::ostream&
+  operator<<(std::ostream& os, const interval_shift& s)
+  {
+    return os << "shift(" << s.offset_ << ",[" << +s.min_ << ".." << +s.max_ << "])";
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::values
+
+namespace std {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Hash specialization for sdd::values::interval_set
+template <typename Value>
+struct hash<sdd::values::interval_set<Value>>
+{
+  std::size_t
+  operator()(const sdd::values::interval_set<Value>& s)
+  const noexcept
+  {
+    using namespace sdd::hash;
+    std::size_t seed = 0;
+    for (const auto& i : s.intervals())
+    {
+      hash_combine(seed, i.first);
+      hash_combine(seed, i.second);
+    }
+    return seed;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Hash specialization for sdd::values::interval_shift
+template <typename Value>
+struct hash<sdd::values::interval_shift<Value>>
+{
+  std::size_t
+  operator()(const sdd::values::interval_shift<Value>& s)
+  const noexcept
+  {
+    using namespace sdd::hash;
+    return seed(s.offset()) (val(s.min())) (val(s.max()));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace std
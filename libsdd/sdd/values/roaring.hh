@@ -0,0 +1,1065 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm>   // lower_bound, set_union, sort, unique
+#include <cassert>
+#include <cstdint>     // uint16_t, uint32_t
+#include <functional>  // hash
+#include <initializer_list>
+#include <iosfwd>
+#include <iterator>    // back_inserter, forward_iterator_tag
+#include <vector>
+
+#include "sdd/values_manager.hh"
+#include "sdd/mem/ptr.hh"
+#include "sdd/mem/unique.hh"
+#include "sdd/util/hash.hh"
+#include "sdd/values/values_traits.hh"
+#include "sdd/values/wide_bitset.hh" // bit_kernels
+
+namespace sdd { namespace values {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The values of a roaring set which share the same 16 high bits.
+///
+/// Depending on which is the smallest, values are stored in a sorted array, in a bitmap, or as a
+/// sorted list of runs of consecutive values. As this choice only depends on the values, two
+/// equal containers have the same representation.
+class roaring_container
+{
+public:
+
+  /// @brief The representation of a container.
+  enum class kind : std::uint8_t {array, bitmap, run};
+
+  /// @brief The maximal number of values in an array container.
+  static constexpr std::size_t max_array = 4096;
+
+  /// @brief The number of words of a bitmap container.
+  static constexpr std::size_t bitmap_words = (1 << 16) / bit_word_size;
+
+  /// @brief Returned by next() when there is no more values.
+  static constexpr std::uint32_t npos = 1 << 16;
+
+private:
+
+  /// @brief The 16 high bits of the values.
+  std::uint16_t key_;
+
+  /// @brief The representation of this container.
+  kind kind_;
+
+  /// @brief The number of values.
+  std::uint32_t cardinality_;
+
+  /// @brief The hash of this container, computed once.
+  std::size_t hash_;
+
+  /// @brief Sorted values for an array, pairs of (first, last) values for runs.
+  std::vector<std::uint16_t> values_;
+
+  /// @brief The bits of a bitmap.
+  std::vector<bit_word> words_;
+
+public:
+
+  /// @brief Construct a container from sorted and unique low bits.
+  static
+  roaring_container
+  from_sorted(std::uint16_t key, const std::uint16_t* begin, const std::uint16_t* end)
+  {
+    const auto cardinality = static_cast<std::size_t>(end - begin);
+    std::size_t nb_runs = 0;
+    for (auto cit = begin; cit != end; ++cit)
+    {
+      if (cit == begin or *cit != *(cit - 1) + 1)
+      {
+        ++nb_runs;
+      }
+    }
+
+    roaring_container res(key, best_kind(cardinality, nb_runs), cardinality);
+    switch (res.kind_)
+    {
+      case kind::array:
+        res.values_.assign(begin, end);
+        break;
+
+      case kind::run:
+        res.values_.reserve(nb_runs * 2);
+        for (auto cit = begin; cit != end; ++cit)
+        {
+          if (cit == begin or *cit != *(cit - 1) + 1)
+          {
+            res.values_.push_back(*cit);
+            res.values_.push_back(*cit);
+          }
+          else
+          {
+            res.values_.back() = *cit;
+          }
+        }
+        break;
+
+      case kind::bitmap:
+        res.words_.assign(bitmap_words, 0);
+        for (auto cit = begin; cit != end; ++cit)
+        {
+          res.words_[*cit / bit_word_size] |= bit_word(1) << (*cit % bit_word_size);
+        }
+        break;
+    }
+    res.compute_hash();
+    return res;
+  }
+
+  /// @brief Construct a container from a bitmap of bitmap_words words.
+  static
+  roaring_container
+  from_bitmap(std::uint16_t key, std::vector<bit_word>&& words)
+  {
+    assert(words.size() == bitmap_words);
+    const auto cardinality = bit_kernels::count(words.data(), bitmap_words);
+    // A run starts at each bit set to 1 whose previous bit is 0.
+    std::size_t nb_runs = 0;
+    bit_word carry = 0;
+    for (const auto w : words)
+    {
+      nb_runs += static_cast<std::size_t>(__builtin_popcountll(w & ~((w << 1) | carry)));
+      carry = w >> (bit_word_size - 1);
+    }
+
+    roaring_container res(key, best_kind(cardinality, nb_runs), cardinality);
+    if (res.kind_ == kind::bitmap)
+    {
+      res.words_ = std::move(words);
+    }
+    else
+    {
+      for ( auto v = next_in_bitmap(words.data(), 0); v != npos
+          ; v = next_in_bitmap(words.data(), v + 1))
+      {
+        if (res.kind_ == kind::array)
+        {
+          res.values_.push_back(static_cast<std::uint16_t>(v));
+        }
+        else if (res.values_.empty() or v != res.values_.back() + 1u)
+        {
+          res.values_.push_back(static_cast<std::uint16_t>(v));
+          res.values_.push_back(static_cast<std::uint16_t>(v));
+        }
+        else
+        {
+          res.values_.back() = static_cast<std::uint16_t>(v);
+        }
+      }
+    }
+    res.compute_hash();
+    return res;
+  }
+
+  std::uint16_t
+  key()
+  const noexcept
+  {
+    return key_;
+  }
+
+  kind
+  representation()
+  const noexcept
+  {
+    return kind_;
+  }
+
+  std::size_t
+  cardinality()
+  const noexcept
+  {
+    return cardinality_;
+  }
+
+  std::size_t
+  hash()
+  const noexcept
+  {
+    return hash_;
+  }
+
+  /// @brief Tell if the low bits v are in this container.
+  bool
+  contains(std::uint16_t v)
+  const noexcept
+  {
+    switch (kind_)
+    {
+      case kind::array:
+        return std::binary_search(values_.begin(), values_.end(), v);
+
+      case kind::bitmap:
+        return (words_[v / bit_word_size] >> (v % bit_word_size)) & 1;
+
+      case kind::run:
+        return run_containing(v) != npos;
+    }
+    __builtin_unreachable();
+  }
+
+  /// @brief Get the first low bits in this container greater or equal than from, or npos.
+  std::uint32_t
+  next(std::uint32_t from)
+  const noexcept
+  {
+    if (from >= npos)
+    {
+      return npos;
+    }
+    switch (kind_)
+    {
+      case kind::array:
+      {
+        const auto search = std::lower_bound(values_.begin(), values_.end(), from);
+        return search == values_.end() ? npos : *search;
+      }
+
+      case kind::bitmap:
+        return next_in_bitmap(words_.data(), from);
+
+      case kind::run:
+      {
+        const auto run = first_run_from(from);
+        return run < values_.size() ? std::max<std::uint32_t>(values_[run], from) : npos;
+      }
+    }
+    __builtin_unreachable();
+  }
+
+  /// @brief Write the bits of this container in bitmap_words words.
+  void
+  to_bitmap(bit_word* words)
+  const noexcept
+  {
+    switch (kind_)
+    {
+      case kind::bitmap:
+        std::copy(words_.begin(), words_.end(), words);
+        break;
+
+      case kind::array:
+        std::fill(words, words + bitmap_words, 0);
+        for (const auto v : values_)
+        {
+          words[v / bit_word_size] |= bit_word(1) << (v % bit_word_size);
+        }
+        break;
+
+      case kind::run:
+        std::fill(words, words + bitmap_words, 0);
+        for (std::size_t run = 0; run < values_.size(); run += 2)
+        {
+          for (std::uint32_t v = values_[run]; v <= values_[run + 1]; ++v)
+          {
+            words[v / bit_word_size] |= bit_word(1) << (v % bit_word_size);
+          }
+        }
+        break;
+    }
+  }
+
+  /// @brief Get the sorted values of an array container.
+  const std::vector<std::uint16_t>&
+  array()
+  const noexcept
+  {
+    assert(kind_ == kind::array);
+    return values_;
+  }
+
+  friend
+  bool
+  operator==(const roaring_container& lhs, const roaring_container& rhs)
+  noexcept
+  {
+    return lhs.hash_ == rhs.hash_ and lhs.key_ == rhs.key_ and lhs.kind_ == rhs.kind_
+       and lhs.cardinality_ == rhs.cardinality_ and lhs.values_ == rhs.values_
+       and lhs.words_ == rhs.words_;
+  }
+
+private:
+
+  roaring_container(std::uint16_t key, kind k, std::size_t cardinality)
+    : key_(key), kind_(k), cardinality_(static_cast<std::uint32_t>(cardinality)), hash_(0)
+    , values_(), words_()
+  {}
+
+  /// @brief Choose the smallest representation.
+  static
+  kind
+  best_kind(std::size_t cardinality, std::size_t nb_runs)
+  noexcept
+  {
+    const auto array_bytes = cardinality * sizeof(std::uint16_t);
+    const auto bitmap_bytes = bitmap_words * sizeof(bit_word);
+    const auto run_bytes = nb_runs * 2 * sizeof(std::uint16_t);
+    if (run_bytes < std::min(array_bytes, bitmap_bytes))
+    {
+      return kind::run;
+    }
+    return cardinality <= max_array ? kind::array : kind::bitmap;
+  }
+
+  void
+  compute_hash()
+  noexcept
+  {
+    using namespace sdd::hash;
+    hash_ = seed(key_) (val(static_cast<std::uint8_t>(kind_))) (range(values_)) (range(words_));
+  }
+
+  /// @brief Get the first bit set to 1 from a position, or npos.
+  static
+  std::uint32_t
+  next_in_bitmap(const bit_word* words, std::uint32_t from)
+  noexcept
+  {
+    if (from >= npos)
+    {
+      return npos;
+    }
+    auto w = from / bit_word_size;
+    auto word = words[w] & (~bit_word(0) << (from % bit_word_size));
+    while (word == 0)
+    {
+      if (++w == bitmap_words)
+      {
+        return npos;
+      }
+      word = words[w];
+    }
+    return static_cast<std::uint32_t>(w * bit_word_size)
+         + static_cast<std::uint32_t>(__builtin_ctzll(word));
+  }
+
+  /// @brief Get the index of the first run whose last value is greater or equal than v.
+  std::size_t
+  first_run_from(std::uint32_t v)
+  const noexcept
+  {
+    std::size_t low = 0;
+    std::size_t high = values_.size() / 2;
+    while (low < high)
+    {
+      const auto mid = (low + high) / 2;
+      if (values_[2 * mid + 1] < v)
+      {
+        low = mid + 1;
+      }
+      else
+      {
+        high = mid;
+      }
+    }
+    return 2 * low;
+  }
+
+  /// @brief Get the index of the run containing v, or npos.
+  std::size_t
+  run_containing(std::uint16_t v)
+  const noexcept
+  {
+    const auto run = first_run_from(v);
+    return run < values_.size() and values_[run] <= v ? run : npos;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The unified data of a roaring set: containers sorted by keys.
+struct roaring_data
+{
+  /// @brief The non-empty containers.
+  std::vector<roaring_container> containers;
+
+  /// @brief The number of values.
+  std::size_t cardinality;
+
+  /// @brief Combine the hashes of containers, which are computed once.
+  std::size_t hash;
+
+  roaring_data()
+    : containers(), cardinality(0), hash(0)
+  {}
+
+  roaring_data(std::vector<roaring_container>&& c)
+    : containers(std::move(c)), cardinality(0), hash(0)
+  {
+    for (const auto& container : containers)
+    {
+      cardinality += container.cardinality();
+      sdd::hash::hash_combine(hash, container.hash());
+    }
+  }
+
+  friend
+  bool
+  operator==(const roaring_data& lhs, const roaring_data& rhs)
+  noexcept
+  {
+    return lhs.hash == rhs.hash and lhs.cardinality == rhs.cardinality
+       and lhs.containers == rhs.containers;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::values
+
+namespace std {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Hash specialization for sdd::values::roaring_data
+template <>
+struct hash<sdd::values::roaring_data>
+{
+  std::size_t
+  operator()(const sdd::values::roaring_data& x)
+  const noexcept
+  {
+    return x.hash;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace std
+
+namespace sdd { namespace values {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief A unified set of 32 bits values, for large and sparse domains.
+///
+/// Values are grouped by their 16 high bits in containers (see roaring_container) which are
+/// shared by the sets computed from them.
+class roaring final
+{
+public:
+
+  /// @brief The type of the contained value.
+  using value_type = std::uint32_t;
+
+  /// @internal
+  using data_type = roaring_data;
+
+  /// @internal
+  using unique_type = mem::unique<data_type>;
+
+  /// @internal
+  using ptr_type = mem::ptr<unique_type>;
+
+  /// @brief Iterate on values, in increasing order.
+  class const_iterator
+  {
+  public:
+
+    using iterator_category = std::forward_iterator_tag;
+    using value_type        = std::uint32_t;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const std::uint32_t*;
+    using reference         = std::uint32_t;
+
+  private:
+
+    const std::vector<roaring_container>* containers_;
+    std::size_t container_;
+    std::uint32_t low_;
+
+  public:
+
+    const_iterator(const std::vector<roaring_container>& containers, std::size_t container)
+    noexcept
+      : containers_(&containers), container_(container)
+      , low_(container < containers.size() ? containers[container].next(0) : 0)
+    {}
+
+    std::uint32_t
+    operator*()
+    const noexcept
+    {
+      return (static_cast<std::uint32_t>((*containers_)[container_].key()) << 16) | low_;
+    }
+
+    const_iterator&
+    operator++()
+    noexcept
+    {
+      low_ = (*containers_)[container_].next(low_ + 1);
+      if (low_ == roaring_container::npos)
+      {
+        ++container_;
+        low_ = container_ < containers_->size() ? (*containers_)[container_].next(0) : 0;
+      }
+      return *this;
+    }
+
+    const_iterator
+    operator++(int)
+    noexcept
+    {
+      auto tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    friend
+    bool
+    operator==(const const_iterator& lhs, const const_iterator& rhs)
+    noexcept
+    {
+      return lhs.container_ == rhs.container_ and lhs.low_ == rhs.low_;
+    }
+
+    friend
+    bool
+    operator!=(const const_iterator& lhs, const const_iterator& rhs)
+    noexcept
+    {
+      return not (lhs == rhs);
+    }
+  };
+
+private:
+
+  /// @brief A pointer to the unified set of values.
+  ptr_type ptr_;
+
+public:
+
+  /// @brief Default copy constructor.
+  roaring(const roaring&) = default;
+
+  /// @brief Default copy operator.
+  roaring& operator=(const roaring&) = default;
+
+  /// @brief Default constructor.
+  roaring()
+    : ptr_(empty_set())
+  {}
+
+  /// @brief Constructor with a range of values, in any order.
+  template <typename InputIterator>
+  roaring(InputIterator begin, InputIterator end)
+    : ptr_(create(begin, end))
+  {}
+
+  /// @brief Constructor with a initializer_list.
+  roaring(std::initializer_list<value_type> values)
+    : roaring(values.begin(), values.end())
+  {}
+
+  /// @internal
+  /// @brief Constructor from temporary containers.
+  roaring(std::vector<roaring_container>&& containers)
+    : ptr_(create(data_type(std::move(containers))))
+  {}
+
+  /// @brief Insert a value.
+  void
+  insert(value_type x);
+
+  /// @brief Tell if a value is in this set.
+  bool
+  contains(value_type x)
+  const noexcept
+  {
+    const auto& containers = ptr_->data().containers;
+    const auto key = static_cast<std::uint16_t>(x >> 16);
+    const auto search = std::lower_bound( containers.begin(), containers.end(), key
+                                        , [](const roaring_container& c, std::uint16_t k)
+                                            {return c.key() < k;});
+    return search != containers.end() and search->key() == key
+       and search->contains(static_cast<std::uint16_t>(x));
+  }
+
+  const_iterator
+  begin()
+  const noexcept
+  {
+    return {ptr_->data().containers, 0};
+  }
+
+  const_iterator
+  end()
+  const noexcept
+  {
+    return {ptr_->data().containers, ptr_->data().containers.size()};
+  }
+
+  /// @brief Tell if this set of values is empty.
+  bool
+  empty()
+  const noexcept
+  {
+    return ptr_->data().containers.empty();
+  }
+
+  /// @brief Get the number of contained values.
+  ///
+  /// O(1).
+  std::size_t
+  size()
+  const noexcept
+  {
+    return ptr_->data().cardinality;
+  }
+
+  /// @internal
+  /// @brief Get the containers.
+  const std::vector<roaring_container>&
+  containers()
+  const noexcept
+  {
+    return ptr_->data().containers;
+  }
+
+  /// @internal
+  /// @brief Get the pointer to the unified data.
+  ptr_type
+  ptr()
+  const noexcept
+  {
+    return ptr_;
+  }
+
+  /// @internal
+  static
+  ptr_type
+  empty_set();
+
+  /// @brief Equality.
+  ///
+  /// O(1).
+  friend
+  bool
+  operator==(const roaring& lhs, const roaring& rhs)
+  noexcept
+  {
+    return lhs.ptr_ == rhs.ptr_;
+  }
+
+  /// @brief Inequality.
+  ///
+  /// O(1).
+  friend
+  bool
+  operator!=(const roaring& lhs, const roaring& rhs)
+  noexcept
+  {
+    return not (lhs.ptr_ == rhs.ptr_);
+  }
+
+  /// @brief Less than comparison.
+  ///
+  /// O(1). The order on roaring is arbitrary.
+  friend
+  bool
+  operator<(const roaring& lhs, const roaring& rhs)
+  noexcept
+  {
+    return lhs.ptr_ < rhs.ptr_;
+  }
+
+private:
+
+  /// @brief Create a smart pointer to a unified set of values, from a pair of iterators.
+  template <typename InputIterator>
+  static
+  ptr_type
+  create(InputIterator begin, InputIterator end)
+  {
+    std::vector<value_type> values(begin, end);
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+
+    std::vector<roaring_container> containers;
+    std::vector<std::uint16_t> low;
+    for (auto cit = values.begin(); cit != values.end();)
+    {
+      const auto key = static_cast<std::uint16_t>(*cit >> 16);
+      low.clear();
+      for (; cit != values.end() and (*cit >> 16) == key; ++cit)
+      {
+        low.push_back(static_cast<std::uint16_t>(*cit));
+      }
+      containers.push_back(roaring_container::from_sorted(key, low.data(), low.data() + low.size()));
+    }
+    return create(data_type(std::move(containers)));
+  }
+
+  /// @brief Create a smart pointer to a unified set of values, from a temporary data.
+  static
+  ptr_type
+  create(data_type&& x)
+  {
+    if (x.containers.empty())
+    {
+      return empty_set();
+    }
+    else
+    {
+      return ptr_type(&unify(std::move(x)));
+    }
+  }
+
+  /// @brief Return the unified version of a data.
+  static
+  unique_type&
+  unify(data_type&& x);
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Will be used by sdd::manager.
+struct roaring_manager
+{
+  /// @brief The type of a unified roaring.
+  using unique_type = roaring::unique_type;
+
+  /// @brief The type of smart pointer to a unified roaring.
+  using ptr_type = roaring::ptr_type;
+
+  /// @brief The type of this manager's statistics.
+  using statistics_type = mem::unique_table_statistics;
+
+  /// @brief Manage the handler needed by ptr when a unified data is no longer referenced.
+  struct ptr_handler
+  {
+    ptr_handler(mem::unique_table<unique_type>& ut)
+    {
+      mem::set_deletion_table(ut);
+    }
+
+    ~ptr_handler()
+    {
+      mem::reset_deletion_table<mem::unique_table<unique_type>>();
+    }
+  } handler;
+
+  /// @brief The set of unified roaring.
+  mem::unique_table<unique_type> unique_table;
+
+  /// @brief The cached empty roaring.
+  const ptr_type empty;
+
+  /// @brief Constructor.
+  template <typename C>
+  roaring_manager(const C& configuration)
+    : handler(unique_table)
+    , unique_table(configuration.roaring_unique_table_size)
+    , empty(mk_empty())
+  {}
+
+  const statistics_type&
+  statistics()
+  const noexcept
+  {
+    return unique_table.stats();
+  }
+
+private:
+
+  /// @brief Helper to construct the empty roaring.
+  ptr_type
+  mk_empty()
+  {
+    char* addr = unique_table.allocate(0 /*extra bytes*/);
+    unique_type* u = new (addr) unique_type;
+    return ptr_type(&unique_table(u, 0));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @related roaring
+///
+/// Indicate to the library that roaring needs to store a global state. It's not "fast iterable":
+/// large sets are better handled by the set operations than value by value.
+template <>
+struct values_traits<roaring>
+{
+  static constexpr bool stateful = true;
+  static constexpr bool fast_iterable = false;
+  static constexpr bool has_value_type = true;
+  using state_type = roaring_manager;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+inline
+roaring::ptr_type
+roaring::empty_set()
+{
+  return global_values<roaring>().state.empty;
+}
+
+inline
+roaring::unique_type&
+roaring::unify(data_type&& x)
+{
+  auto& ut = global_values<roaring>().state.unique_table;
+  char* addr = ut.allocate(0 /*extra bytes*/);
+  unique_type* u = new (addr) unique_type(std::move(x));
+  return ut(u, 0);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Apply a set operation on each pair of containers with the same key.
+///
+/// Containers of lhs (resp. rhs) without a counterpart are kept if keep_lhs (resp. keep_rhs).
+template <typename Operation>
+inline
+roaring
+roaring_apply( const roaring& lhs, const roaring& rhs, bool keep_lhs, bool keep_rhs
+             , Operation&& op)
+{
+  std::vector<roaring_container> res;
+  res.reserve(lhs.containers().size() + rhs.containers().size());
+  auto lhs_cit = lhs.containers().begin();
+  auto rhs_cit = rhs.containers().begin();
+  const auto lhs_end = lhs.containers().end();
+  const auto rhs_end = rhs.containers().end();
+  while (lhs_cit != lhs_end or rhs_cit != rhs_end)
+  {
+    if (rhs_cit == rhs_end or (lhs_cit != lhs_end and lhs_cit->key() < rhs_cit->key()))
+    {
+      if (keep_lhs)
+      {
+        res.push_back(*lhs_cit);
+      }
+      ++lhs_cit;
+    }
+    else if (lhs_cit == lhs_end or rhs_cit->key() < lhs_cit->key())
+    {
+      if (keep_rhs)
+      {
+        res.push_back(*rhs_cit);
+      }
+      ++rhs_cit;
+    }
+    else
+    {
+      op(*lhs_cit++, *rhs_cit++, res);
+    }
+  }
+  return roaring(std::move(res));
+}
+
+/// @internal
+/// @brief Apply a bitwise kernel on two containers, and add the non-empty result to res.
+template <typename Kernel>
+inline
+void
+roaring_bitwise( const roaring_container& lhs, const roaring_container& rhs
+               , std::vector<roaring_container>& res, Kernel&& kernel)
+{
+  std::vector<bit_word> lhs_words(roaring_container::bitmap_words);
+  std::vector<bit_word> rhs_words(roaring_container::bitmap_words);
+  lhs.to_bitmap(lhs_words.data());
+  rhs.to_bitmap(rhs_words.data());
+  kernel(lhs_words.data(), lhs_words.data(), rhs_words.data(), roaring_container::bitmap_words);
+  if (not bit_kernels::none(lhs_words.data(), roaring_container::bitmap_words))
+  {
+    res.push_back(roaring_container::from_bitmap(lhs.key(), std::move(lhs_words)));
+  }
+}
+
+/// @internal
+/// @brief Keep the values of an array container which are in (or not in) another container.
+inline
+void
+roaring_filter( const roaring_container& array, const roaring_container& other, bool in
+              , std::vector<roaring_container>& res)
+{
+  std::vector<std::uint16_t> values;
+  values.reserve(array.cardinality());
+  for (const auto v : array.array())
+  {
+    if (other.contains(v) == in)
+    {
+      values.push_back(v);
+    }
+  }
+  if (not values.empty())
+  {
+    res.push_back(roaring_container::from_sorted( array.key(), values.data()
+                                                , values.data() + values.size()));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @related roaring
+inline
+roaring
+sum(const roaring& lhs, const roaring& rhs)
+{
+  using kind = roaring_container::kind;
+  return roaring_apply(lhs, rhs, true, true, [](const auto& l, const auto& r, auto& res)
+  {
+    if (l == r)
+    {
+      res.push_back(l);
+    }
+    else if (l.representation() == kind::array and r.representation() == kind::array
+             and l.cardinality() + r.cardinality() <= roaring_container::max_array)
+    {
+      std::vector<std::uint16_t> values;
+      values.reserve(l.cardinality() + r.cardinality());
+      std::set_union( l.array().begin(), l.array().end(), r.array().begin(), r.array().end()
+                    , std::back_inserter(values));
+      res.push_back(roaring_container::from_sorted( l.key(), values.data()
+                                                  , values.data() + values.size()));
+    }
+    else
+    {
+      roaring_bitwise(l, r, res, bit_kernels::bitwise_or);
+    }
+  });
+}
+
+/// @related roaring
+inline
+roaring
+intersection(const roaring& lhs, const roaring& rhs)
+{
+  using kind = roaring_container::kind;
+  return roaring_apply(lhs, rhs, false, false, [](const auto& l, const auto& r, auto& res)
+  {
+    if (l == r)
+    {
+      res.push_back(l);
+    }
+    else if (l.representation() == kind::array)
+    {
+      roaring_filter(l, r, true, res);
+    }
+    else if (r.representation() == kind::array)
+    {
+      roaring_filter(r, l, true, res);
+    }
+    else
+    {
+      roaring_bitwise(l, r, res, bit_kernels::bitwise_and);
+    }
+  });
+}
+
+/// @related roaring
+inline
+roaring
+difference(const roaring& lhs, const roaring& rhs)
+{
+  using kind = roaring_container::kind;
+  return roaring_apply(lhs, rhs, true, false, [](const auto& l, const auto& r, auto& res)
+  {
+    if (l == r)
+    {
+      return;
+    }
+    else if (l.representation() == kind::array)
+    {
+      roaring_filter(l, r, false, res);
+    }
+    else
+    {
+      roaring_bitwise(l, r, res, bit_kernels::bitwise_and_not);
+    }
+  });
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+inline
+void
+roaring::insert(value_type x)
+{
+  if (not contains(x))
+  {
+    *this = sum(*this, roaring{x});
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Textual output of a roaring.
+///
+/// Consecutive values are displayed like 1..9.
+/// @related roaring
+inline
+std::ostream&
+operator<<(std::ostream& os, const roaring& r)
+{
+  os << "{";
+  bool first = true;
+  for (auto cit = r.begin(); cit != r.end();)
+  {
+    const auto start = *cit;
+    auto last = start;
+    for (++cit; cit != r.end() and *cit == last + 1; ++cit)
+    {
+      last = *cit;
+    }
+    if (not first)
+    {
+      os << ",";
+    }
+    first = false;
+    if (start == last)
+    {
+      os << start;
+    }
+    else
+    {
+      os << start << ".." << last;
+    }
+  }
+  return os << "}";
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::values
+
+namespace std {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Hash specialization for sdd::values::roaring
+template <>
+struct hash<sdd::values::roaring>
+{
+  std::size_t
+  operator()(const sdd::values::roaring& r)
+  const noexcept
+  {
+    return sdd::hash::seed(r.ptr());
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace std
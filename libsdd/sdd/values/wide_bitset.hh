@@ -0,0 +1,734 @@
+/// @file
+/// @copyright The code is licensed under the BSD License
+///            <http://opensource.org/licenses/BSD-2-Clause>,
+///            Copyright (c) 2012-2015 Alexandre Hamez.
+/// @author Alexandre Hamez
+
+#pragma once
+
+#include <algorithm> // equal, lexicographical_compare, max, min
+#include <array>
+#include <cassert>
+#include <cstdint>   // uint64_t
+#include <functional> // hash
+#include <initializer_list>
+#include <iterator>  // forward_iterator_tag
+#include <ostream>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+#include "sdd/util/hash.hh"
+#include "sdd/values/values_traits.hh"
+
+namespace sdd { namespace values {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief The type of the words which store the bits of wide bitsets.
+using bit_word = std::uint64_t;
+
+/// @internal
+/// @brief The number of bits in a bit_word.
+static constexpr std::size_t bit_word_size = 64;
+
+/// @internal
+/// @brief Word-wise kernels of wide bitsets.
+///
+/// They process 8 words at once when the compiler targets AVX-512, 4 words with AVX2, and fall
+/// back to a scalar loop for the remaining words.
+struct bit_kernels
+{
+  /// @brief dst[i] = lhs[i] | rhs[i]
+  static
+  void
+  bitwise_or(bit_word* dst, const bit_word* lhs, const bit_word* rhs, std::size_t n)
+  noexcept
+  {
+    std::size_t i = 0;
+#if defined(__AVX512F__)
+    for (; i < n - n % 8; i += 8)
+    {
+      const auto v = _mm512_or_si512(_mm512_loadu_si512(lhs + i), _mm512_loadu_si512(rhs + i));
+      _mm512_storeu_si512(dst + i, v);
+    }
+#endif
+#if defined(__AVX2__)
+    for (; i < n - n % 4; i += 4)
+    {
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>(dst + i)
+                         , _mm256_or_si256(load(lhs + i), load(rhs + i)));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+      dst[i] = lhs[i] | rhs[i];
+    }
+  }
+
+  /// @brief dst[i] = lhs[i] & rhs[i]
+  static
+  void
+  bitwise_and(bit_word* dst, const bit_word* lhs, const bit_word* rhs, std::size_t n)
+  noexcept
+  {
+    std::size_t i = 0;
+#if defined(__AVX512F__)
+    for (; i < n - n % 8; i += 8)
+    {
+      const auto v = _mm512_and_si512(_mm512_loadu_si512(lhs + i), _mm512_loadu_si512(rhs + i));
+      _mm512_storeu_si512(dst + i, v);
+    }
+#endif
+#if defined(__AVX2__)
+    for (; i < n - n % 4; i += 4)
+    {
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>(dst + i)
+                         , _mm256_and_si256(load(lhs + i), load(rhs + i)));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+      dst[i] = lhs[i] & rhs[i];
+    }
+  }
+
+  /// @brief dst[i] = lhs[i] & ~rhs[i]
+  static
+  void
+  bitwise_and_not(bit_word* dst, const bit_word* lhs, const bit_word* rhs, std::size_t n)
+  noexcept
+  {
+    std::size_t i = 0;
+#if defined(__AVX512F__)
+    for (; i < n - n % 8; i += 8)
+    {
+      const auto v = _mm512_andnot_si512(_mm512_loadu_si512(rhs + i), _mm512_loadu_si512(lhs + i));
+      _mm512_storeu_si512(dst + i, v);
+    }
+#endif
+#if defined(__AVX2__)
+    for (; i < n - n % 4; i += 4)
+    {
+      _mm256_storeu_si256( reinterpret_cast<__m256i*>(dst + i)
+                         , _mm256_andnot_si256(load(rhs + i), load(lhs + i)));
+    }
+#endif
+    for (; i < n; ++i)
+    {
+      dst[i] = lhs[i] & ~rhs[i];
+    }
+  }
+
+  /// @brief Tell if all words are 0.
+  static
+  bool
+  none(const bit_word* words, std::size_t n)
+  noexcept
+  {
+    std::size_t i = 0;
+#if defined(__AVX2__)
+    for (; i < n - n % 4; i += 4)
+    {
+      const auto v = load(words + i);
+      if (not _mm256_testz_si256(v, v))
+      {
+        return false;
+      }
+    }
+#endif
+    for (; i < n; ++i)
+    {
+      if (words[i] != 0)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// @brief The number of bits set to 1.
+  static
+  std::size_t
+  count(const bit_word* words, std::size_t n)
+  noexcept
+  {
+    std::size_t res = 0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      res += static_cast<std::size_t>(__builtin_popcountll(words[i]));
+    }
+    return res;
+  }
+
+private:
+
+#if defined(__AVX2__)
+  static
+  __m256i
+  load(const bit_word* p)
+  noexcept
+  {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+#endif
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Iterate on the bits set to 1 of an array of words, in increasing order.
+class bit_iterator
+{
+public:
+
+  using iterator_category = std::forward_iterator_tag;
+  using value_type        = std::size_t;
+  using difference_type   = std::ptrdiff_t;
+  using pointer           = const std::size_t*;
+  using reference         = std::size_t;
+
+private:
+
+  const bit_word* words_;
+  std::size_t nb_words_;
+
+  /// @brief The current bit, nb_words_ * bit_word_size at the end.
+  std::size_t pos_;
+
+public:
+
+  bit_iterator(const bit_word* words, std::size_t nb_words, std::size_t pos)
+  noexcept
+    : words_(words), nb_words_(nb_words), pos_(pos)
+  {
+    if (pos_ < nb_words_ * bit_word_size and not (words_[pos_ / bit_word_size] & mask(pos_)))
+    {
+      next();
+    }
+  }
+
+  std::size_t
+  operator*()
+  const noexcept
+  {
+    return pos_;
+  }
+
+  bit_iterator&
+  operator++()
+  noexcept
+  {
+    ++pos_;
+    if (pos_ < nb_words_ * bit_word_size)
+    {
+      next();
+    }
+    return *this;
+  }
+
+  bit_iterator
+  operator++(int)
+  noexcept
+  {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  friend
+  bool
+  operator==(const bit_iterator& lhs, const bit_iterator& rhs)
+  noexcept
+  {
+    return lhs.pos_ == rhs.pos_;
+  }
+
+  friend
+  bool
+  operator!=(const bit_iterator& lhs, const bit_iterator& rhs)
+  noexcept
+  {
+    return not (lhs == rhs);
+  }
+
+private:
+
+  static
+  bit_word
+  mask(std::size_t pos)
+  noexcept
+  {
+    return bit_word(1) << (pos % bit_word_size);
+  }
+
+  /// @brief Move to the first bit set to 1 from pos_, included.
+  void
+  next()
+  noexcept
+  {
+    auto w = pos_ / bit_word_size;
+    auto word = words_[w] & (~bit_word(0) << (pos_ % bit_word_size));
+    while (word == 0)
+    {
+      if (++w == nb_words_)
+      {
+        pos_ = nb_words_ * bit_word_size;
+        return;
+      }
+      word = words_[w];
+    }
+    pos_ = w * bit_word_size + static_cast<std::size_t>(__builtin_ctzll(word));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Encode a set of values using bits, for domains larger than bitset can handle.
+///
+/// Values must be lower than Size.
+template <std::size_t Size>
+class wide_bitset final
+{
+public:
+
+  using value_type = std::size_t;
+  using const_iterator = bit_iterator;
+
+  /// @brief The number of words which store the bits.
+  static constexpr std::size_t nb_words = (Size + bit_word_size - 1) / bit_word_size;
+
+private:
+
+  std::array<bit_word, nb_words> words_;
+
+public:
+
+  wide_bitset()
+  noexcept
+    : words_()
+  {}
+
+  wide_bitset(std::initializer_list<value_type> values)
+    : words_()
+  {
+    for (auto v : values)
+    {
+      insert(v);
+    }
+  }
+
+  friend
+  bool
+  operator==(const wide_bitset& lhs, const wide_bitset& rhs)
+  noexcept
+  {
+    return lhs.words_ == rhs.words_;
+  }
+
+  friend
+  bool
+  operator!=(const wide_bitset& lhs, const wide_bitset& rhs)
+  noexcept
+  {
+    return not (lhs == rhs);
+  }
+
+  friend
+  bool
+  operator<(const wide_bitset& lhs, const wide_bitset& rhs)
+  noexcept
+  {
+    return lhs.words_ < rhs.words_;
+  }
+
+  wide_bitset&
+  insert(value_type v)
+  noexcept
+  {
+    assert(v < Size);
+    words_[v / bit_word_size] |= bit_word(1) << (v % bit_word_size);
+    return *this;
+  }
+
+  bool
+  test(value_type v)
+  const noexcept
+  {
+    return v < Size and (words_[v / bit_word_size] >> (v % bit_word_size)) & 1;
+  }
+
+  std::size_t
+  size()
+  const noexcept
+  {
+    return bit_kernels::count(words_.data(), nb_words);
+  }
+
+  bool
+  empty()
+  const noexcept
+  {
+    return bit_kernels::none(words_.data(), nb_words);
+  }
+
+  const_iterator
+  begin()
+  const noexcept
+  {
+    return {words_.data(), nb_words, 0};
+  }
+
+  const_iterator
+  end()
+  const noexcept
+  {
+    return {words_.data(), nb_words, nb_words * bit_word_size};
+  }
+
+  /// @brief Get the words which store the bits.
+  const bit_word*
+  data()
+  const noexcept
+  {
+    return words_.data();
+  }
+
+  /// @brief Get the words which store the bits.
+  bit_word*
+  data()
+  noexcept
+  {
+    return words_.data();
+  }
+
+  friend
+  void
+  swap(wide_bitset& lhs, wide_bitset& rhs)
+  noexcept
+  {
+    using std::swap;
+    swap(lhs.words_, rhs.words_);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <std::size_t Size>
+inline
+wide_bitset<Size>
+sum(const wide_bitset<Size>& lhs, const wide_bitset<Size>& rhs)
+noexcept
+{
+  wide_bitset<Size> res;
+  bit_kernels::bitwise_or(res.data(), lhs.data(), rhs.data(), wide_bitset<Size>::nb_words);
+  return res;
+}
+
+template <std::size_t Size>
+inline
+wide_bitset<Size>
+intersection(const wide_bitset<Size>& lhs, const wide_bitset<Size>& rhs)
+noexcept
+{
+  wide_bitset<Size> res;
+  bit_kernels::bitwise_and(res.data(), lhs.data(), rhs.data(), wide_bitset<Size>::nb_words);
+  return res;
+}
+
+template <std::size_t Size>
+inline
+wide_bitset<Size>
+difference(const wide_bitset<Size>& lhs, const wide_bitset<Size>& rhs)
+noexcept
+{
+  wide_bitset<Size> res;
+  bit_kernels::bitwise_and_not(res.data(), lhs.data(), rhs.data(), wide_bitset<Size>::nb_words);
+  return res;
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Encode a set of values using bits, whose number grows with the greatest value.
+///
+/// Trailing words are never 0, thus two equal sets have the same words.
+class dynamic_bitset final
+{
+public:
+
+  using value_type = std::size_t;
+  using const_iterator = bit_iterator;
+
+private:
+
+  std::vector<bit_word> words_;
+
+public:
+
+  dynamic_bitset()
+  noexcept
+    : words_()
+  {}
+
+  dynamic_bitset(std::initializer_list<value_type> values)
+    : words_()
+  {
+    for (auto v : values)
+    {
+      insert(v);
+    }
+  }
+
+  /// @internal
+  /// @brief Construct from words, which may end with 0.
+  dynamic_bitset(std::vector<bit_word>&& words)
+  noexcept
+    : words_(std::move(words))
+  {
+    trim();
+  }
+
+  friend
+  bool
+  operator==(const dynamic_bitset& lhs, const dynamic_bitset& rhs)
+  noexcept
+  {
+    return lhs.words_ == rhs.words_;
+  }
+
+  friend
+  bool
+  operator!=(const dynamic_bitset& lhs, const dynamic_bitset& rhs)
+  noexcept
+  {
+    return not (lhs == rhs);
+  }
+
+  friend
+  bool
+  operator<(const dynamic_bitset& lhs, const dynamic_bitset& rhs)
+  noexcept
+  {
+    return lhs.words_.size() < rhs.words_.size()
+        or (lhs.words_.size() == rhs.words_.size() and lhs.words_ < rhs.words_);
+  }
+
+  dynamic_bitset&
+  insert(value_type v)
+  {
+    const auto w = v / bit_word_size;
+    if (w >= words_.size())
+    {
+      words_.resize(w + 1, 0);
+    }
+    words_[w] |= bit_word(1) << (v % bit_word_size);
+    return *this;
+  }
+
+  bool
+  test(value_type v)
+  const noexcept
+  {
+    const auto w = v / bit_word_size;
+    return w < words_.size() and (words_[w] >> (v % bit_word_size)) & 1;
+  }
+
+  std::size_t
+  size()
+  const noexcept
+  {
+    return bit_kernels::count(words_.data(), words_.size());
+  }
+
+  bool
+  empty()
+  const noexcept
+  {
+    return words_.empty();
+  }
+
+  const_iterator
+  begin()
+  const noexcept
+  {
+    return {words_.data(), words_.size(), 0};
+  }
+
+  const_iterator
+  end()
+  const noexcept
+  {
+    return {words_.data(), words_.size(), words_.size() * bit_word_size};
+  }
+
+  /// @brief Get the words which store the bits.
+  const std::vector<bit_word>&
+  words()
+  const noexcept
+  {
+    return words_;
+  }
+
+  friend
+  void
+  swap(dynamic_bitset& lhs, dynamic_bitset& rhs)
+  noexcept
+  {
+    using std::swap;
+    swap(lhs.words_, rhs.words_);
+  }
+
+private:
+
+  /// @brief Remove trailing 0 words.
+  void
+  trim()
+  noexcept
+  {
+    while (not words_.empty() and words_.back() == 0)
+    {
+      words_.pop_back();
+    }
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+inline
+dynamic_bitset
+sum(const dynamic_bitset& lhs, const dynamic_bitset& rhs)
+{
+  const auto& longest = lhs.words().size() >= rhs.words().size() ? lhs.words() : rhs.words();
+  const auto common = std::min(lhs.words().size(), rhs.words().size());
+  std::vector<bit_word> res(longest);
+  bit_kernels::bitwise_or(res.data(), lhs.words().data(), rhs.words().data(), common);
+  return dynamic_bitset(std::move(res));
+}
+
+inline
+dynamic_bitset
+intersection(const dynamic_bitset& lhs, const dynamic_bitset& rhs)
+{
+  const auto common = std::min(lhs.words().size(), rhs.words().size());
+  std::vector<bit_word> res(common);
+  bit_kernels::bitwise_and(res.data(), lhs.words().data(), rhs.words().data(), common);
+  return dynamic_bitset(std::move(res));
+}
+
+inline
+dynamic_bitset
+difference(const dynamic_bitset& lhs, const dynamic_bitset& rhs)
+{
+  const auto common = std::min(lhs.words().size(), rhs.words().size());
+  std::vector<bit_word> res(lhs.words());
+  bit_kernels::bitwise_and_not(res.data(), lhs.words().data(), rhs.words().data(), common);
+  return dynamic_bitset(std::move(res));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @brief Textual output of a set of bits.
+template <typename Bitset>
+std::ostream&
+print_bits(std::ostream& os, const Bitset& b)
+{
+  os << "{";
+  bool first = true;
+  for (const auto v : b)
+  {
+    if (not first)
+    {
+      os << ",";
+    }
+    else
+    {
+      first = false;
+    }
+    os << v;
+  }
+  return os << "}";
+}
+
+template <std::size_t Size>
+std::ostream&
+operator<<(std::ostream& os, const wide_bitset<Size>& b)
+{
+  return print_bits(os, b);
+}
+
+inline
+std::ostream&
+operator<<(std::ostream& os, const dynamic_bitset& b)
+{
+  return print_bits(os, b);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @internal
+/// @related wide_bitset
+///
+/// The linear algorithms on flat nodes can iterate on values.
+template <std::size_t Size>
+struct values_traits<wide_bitset<Size>>
+{
+  static constexpr bool stateful = false;
+  static constexpr bool fast_iterable = true;
+  static constexpr bool has_value_type = true;
+  using builder = wide_bitset<Size>;
+};
+
+/// @internal
+/// @related dynamic_bitset
+///
+/// The linear algorithms on flat nodes can iterate on values.
+template <>
+struct values_traits<dynamic_bitset>
+{
+  static constexpr bool stateful = false;
+  static constexpr bool fast_iterable = true;
+  static constexpr bool has_value_type = true;
+  using builder = dynamic_bitset;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+}} // namespace sdd::values
+
+namespace std {
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Hash specialization for sdd::values::wide_bitset.
+template <std::size_t Size>
+struct hash<sdd::values::wide_bitset<Size>>
+{
+  std::size_t
+  operator()(const sdd::values::wide_bitset<Size>& b)
+  const noexcept
+  {
+    using namespace sdd::hash;
+    return seed() (range(b.data(), b.data() + sdd::values::wide_bitset<Size>::nb_words));
+  }
+};
+
+/// @brief Hash specialization for sdd::values::dynamic_bitset.
+template <>
+struct hash<sdd::values::dynamic_bitset>
+{
+  std::size_t
+  operator()(const sdd::values::dynamic_bitset& b)
+  const noexcept
+  {
+    using namespace sdd::hash;
+    return seed() (range(b.words()));
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+} // namespace std
@@ -1,6 +1,8 @@
 #ifndef _SDD_TESTS_CONFIGURATION_HH_
 #define _SDD_TESTS_CONFIGURATION_HH_
 
+#include <string>
+
 #include "gtest/gtest.h"
 
 #include "sdd/conf/default_configurations.hh"
@@ -10,6 +12,13 @@
 using conf0 = sdd::conf0;
 using conf1 = sdd::conf1;
 
+struct parallel_conf
+  : public sdd::concurrent_configuration
+{
+  using Identifier = std::string;
+  using Values     = sdd::values::bitset<64>;
+};
+
 template <typename C>
 C
 small_conf()
@@ -18,6 +27,7 @@ noexcept
   C c;
   c.sdd_unique_table_size = 1000;
   c.sdd_difference_cache_size = 1000;
+  c.sdd_difference_sum_cache_size = 1000;
   c.sdd_intersection_cache_size = 1000;
   c.sdd_sum_cache_size = 1000;
   c.hom_unique_table_size = 1000;
@@ -25,6 +35,17 @@ noexcept
   return c;
 }
 
+inline
+parallel_conf
+small_parallel_conf()
+noexcept
+{
+  auto c = small_conf<parallel_conf>();
+  c.sdd_nb_threads = 4;
+  c.sdd_parallel_threshold = 1;
+  return c;
+}
+
 /*------------------------------------------------------------------------------------------------*/
 
 using configurations = ::testing::Types<conf0, conf1>;
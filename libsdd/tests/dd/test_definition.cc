@@ -32,7 +32,36 @@ struct definition_test
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @brief Unreferenced SDD are kept until a collection.
+template <typename C>
+struct collection_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> one;
+
+  static
+  C
+  configuration()
+  {
+    auto c = small_conf<C>();
+    c.sdd_collection_threshold = 1000;
+    return c;
+  }
+
+  collection_test()
+    : m(sdd::init(configuration()))
+    , one(sdd::one<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 TYPED_TEST_CASE(definition_test, configurations);
+TYPED_TEST_CASE(collection_test, configurations);
 #include "tests/macros.hh"
 
 /*------------------------------------------------------------------------------------------------*/
@@ -126,3 +155,43 @@ TYPED_TEST(definition_test, check_compatibility)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(definition_test, existing_node)
+{
+  const SDD x(0, {1}, SDD(1, {2}, one));
+  const auto size = this->m.sdd_stats().size;
+  const auto hits = this->m.sdd_stats().hits;
+  const SDD y(0, {1}, SDD(1, {2}, one));
+  ASSERT_EQ(x, y);
+  ASSERT_EQ(size, this->m.sdd_stats().size);
+  ASSERT_EQ(hits + 2, this->m.sdd_stats().hits);
+  ASSERT_NE(x, SDD(0, {1}, SDD(1, {3}, one)));
+  ASSERT_NE(x, SDD(1, {1}, SDD(1, {2}, one)));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(collection_test, deferred_collection)
+{
+  const auto size = this->m.sdd_stats().size;
+  {
+    SDD x(0, {1}, SDD(1, {2}, one));
+  }
+  // Both nodes are kept, waiting for a collection. Only the top one is dead, as it still
+  // references the other one.
+  ASSERT_EQ(size + 2, this->m.sdd_stats().size);
+  ASSERT_EQ(1u, this->m.sdd_stats().dead);
+
+  // Rebuilding x resurrects its top node.
+  {
+    SDD x(0, {1}, SDD(1, {2}, one));
+    ASSERT_EQ(size + 2, this->m.sdd_stats().size);
+    ASSERT_EQ(1u, this->m.sdd_stats().resurrected);
+    ASSERT_EQ(0u, this->m.sdd_stats().dead);
+    ASSERT_EQ(0u, this->m.collect());
+  }
+  ASSERT_EQ(2u, this->m.collect());
+  ASSERT_EQ(size, this->m.sdd_stats().size);
+}
+
+/*------------------------------------------------------------------------------------------------*/
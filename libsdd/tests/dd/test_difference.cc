@@ -178,6 +178,38 @@ TYPED_TEST(difference_test, flat_x_minus_y)
 
 /*------------------------------------------------------------------------------------------------*/
 
+TYPED_TEST(difference_test, flat_wide_alphas)
+{
+  sdd::dd::sum_builder<conf, SDD> x_ops(cxt);
+  sdd::dd::sum_builder<conf, SDD> y_ops(cxt);
+  sdd::dd::sum_builder<conf, SDD> z_ops(cxt);
+  sdd::dd::sum_builder<conf, SDD> ref_ops(cxt);
+  for (unsigned int i = 0; i < 10; ++i)
+  {
+    x_ops.add(SDD(0, {i}, SDD(1, {i, 20}, one)));
+    if (i % 2 == 0)
+    {
+      y_ops.add(SDD(0, {i, i + 30}, SDD(1, {i}, one)));
+      ref_ops.add(SDD(0, {i}, SDD(1, {20}, one)));
+    }
+    else
+    {
+      ref_ops.add(SDD(0, {i}, SDD(1, {i, 20}, one)));
+    }
+    z_ops.add(SDD(0, {i}, SDD(1, {i, 20}, one)));
+  }
+  z_ops.add(SDD(0, {40}, one));
+  const SDD x = sum(cxt, std::move(x_ops));
+  const SDD y = sum(cxt, std::move(y_ops));
+  const SDD z = sum(cxt, std::move(z_ops));
+
+  ASSERT_EQ(sum(cxt, std::move(ref_ops)), difference(cxt, x, y));
+  ASSERT_EQ(zero, difference(cxt, x, z));
+  ASSERT_EQ(SDD(0, {40}, one), difference(cxt, z, x));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 TYPED_TEST(difference_test, hierarchical_x_minus_y)
 {
   {
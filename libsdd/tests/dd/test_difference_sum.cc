@@ -0,0 +1,94 @@
+#include "gtest/gtest.h"
+
+#include "sdd/conf/default_configurations.hh"
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct difference_sum_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+  sdd::dd::context<C>& cxt;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+
+  difference_sum_test()
+    : m(init(small_conf<C>()))
+    , cxt(sdd::global<C>().sdd_context)
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(difference_sum_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(difference_sum_test, trivial)
+{
+  const SDD x(0, {0,1}, one);
+  const SDD y(0, {1,2}, one);
+  const SDD z(0, {3}, one);
+  ASSERT_EQ(z, difference_sum(cxt, x, x, z));
+  ASSERT_EQ(z, difference_sum(cxt, zero, x, z));
+  ASSERT_EQ(x + z, difference_sum(cxt, x, zero, z));
+  ASSERT_EQ(x - y, difference_sum(cxt, x, y, zero));
+  ASSERT_EQ(x + y, difference_sum(cxt, x, y, y));
+  ASSERT_EQ(x, difference_sum(cxt, x, y, x));
+  ASSERT_EQ(zero, difference_sum(cxt, one, one, zero));
+  ASSERT_EQ(one, difference_sum(cxt, one, one, one));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(difference_sum_test, flat)
+{
+  {
+    const SDD x(0, {0,1,2}, SDD(1, {0,1}, one));
+    const SDD y(0, {1,2,3}, SDD(1, {1}, one));
+    const SDD z(0, {2,4}, SDD(1, {2}, one));
+    ASSERT_EQ((x - y) + z, difference_sum(cxt, x, y, z));
+    ASSERT_EQ((y - x) + z, difference_sum(cxt, y, x, z));
+    ASSERT_EQ((x - z) + y, difference_sum(cxt, x, z, y));
+  }
+  {
+    const SDD x(0, {0,1}, SDD(1, {0}, one));
+    const SDD y(0, {0,1}, SDD(1, {0}, one) + SDD(1, {1}, one));
+    const SDD z(0, {5}, SDD(1, {0}, one));
+    ASSERT_EQ(z, difference_sum(cxt, x, y, z));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(difference_sum_test, hierarchical)
+{
+  const SDD x('a', SDD('b', {0,1}, one), SDD('c', {0}, one));
+  const SDD y('a', SDD('b', {1,2}, one), SDD('c', {0}, one));
+  const SDD z('a', SDD('b', {3}, one), SDD('c', {1}, one));
+  ASSERT_EQ((x - y) + z, difference_sum(cxt, x, y, z));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(difference_sum_test, incompatible)
+{
+  ASSERT_THROW( difference_sum(cxt, SDD(0, {0}, one), SDD(1, {0}, one), SDD(0, {1}, one))
+              , sdd::top<conf>);
+  ASSERT_THROW( difference_sum(cxt, SDD(0, {0}, one), SDD(0, {1}, one), SDD(1, {0}, one))
+              , sdd::top<conf>);
+}
+
+/*------------------------------------------------------------------------------------------------*/
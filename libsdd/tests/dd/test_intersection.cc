@@ -240,6 +240,39 @@ TYPED_TEST(intersection_test, flat_nary)
 
 /*------------------------------------------------------------------------------------------------*/
 
+TYPED_TEST(intersection_test, flat_nary_no_intermediate)
+{
+  const SDD s0(1, {0}, one);
+  const SDD s1(1, {1}, one);
+
+  sdd::dd::alpha_builder<conf, values_type> builder0(cxt);
+  builder0.add(values_type {0,1}, s0);
+  builder0.add(values_type {2,3}, s1);
+  const SDD x0(0, std::move(builder0));
+
+  sdd::dd::alpha_builder<conf, values_type> builder1(cxt);
+  builder1.add(values_type {0,1,2}, s0);
+  builder1.add(values_type {3}, s1);
+  const SDD x1(0, std::move(builder1));
+
+  sdd::dd::alpha_builder<conf, values_type> builder2(cxt);
+  builder2.add(values_type {0}, s0);
+  builder2.add(values_type {1,3}, s1);
+  const SDD x2(0, std::move(builder2));
+
+  sdd::dd::alpha_builder<conf, values_type> builder(cxt);
+  builder.add(values_type {0}, s0);
+  builder.add(values_type {3}, s1);
+  const SDD ref(0, std::move(builder));
+
+  // All nodes of the result already exist, thus no node should be created.
+  const auto misses = this->m.sdd_stats().misses;
+  ASSERT_EQ(ref, intersection(cxt, {cxt, {x0, x1, x2}}));
+  ASSERT_EQ(misses, this->m.sdd_stats().misses);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 TYPED_TEST(intersection_test, hierarchical_nary)
 {
   {
@@ -0,0 +1,96 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct parallel_test
+  : public testing::Test
+{
+  using conf   = parallel_conf;
+  using SDD    = sdd::SDD<conf>;
+  using values = sdd::values::bitset<64>;
+
+  sdd::manager<conf> m;
+
+  const SDD one;
+
+  /// @brief 64 flat SDD, each one with a single path.
+  std::vector<SDD> flat;
+
+  /// @brief 64 hierarchical SDD, each one with a single path.
+  std::vector<SDD> hier;
+
+  parallel_test()
+    : m(sdd::init(small_parallel_conf())), one(sdd::one<conf>()), flat(), hier()
+  {
+    for (unsigned int i = 0; i < 64; ++i)
+    {
+      flat.emplace_back( 2, values{i}
+                       , SDD(1, values{(i * 7) % 64}, SDD(0, values{(i * 13) % 64}, one)));
+    }
+    for (unsigned int i = 0; i < 64; ++i)
+    {
+      hier.emplace_back(1, flat[i], SDD(0, flat[(i * 5) % 64], one));
+    }
+  }
+
+  /// @brief Sum the SDD of xs whose index satisfies a predicate.
+  template <typename Predicate>
+  static
+  SDD
+  select(const std::vector<SDD>& xs, Predicate&& pred)
+  {
+    std::vector<SDD> tmp;
+    for (std::size_t i = 0; i < xs.size(); ++i)
+    {
+      if (pred(i))
+      {
+        tmp.push_back(xs[i]);
+      }
+    }
+    return sdd::sum<conf>(tmp.begin(), tmp.end());
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(parallel_test, flat_operations)
+{
+  const auto even = select(flat, [](std::size_t i){return i % 2 == 0;});
+  const auto div3 = select(flat, [](std::size_t i){return i % 3 == 0;});
+  ASSERT_EQ(32u, even.size());
+  ASSERT_EQ(22u, div3.size());
+  ASSERT_EQ(43u, (even + div3).size());
+  ASSERT_EQ(11u, (even & div3).size());
+  ASSERT_EQ(21u, (even - div3).size());
+  ASSERT_EQ(even, (even - div3) + (even & div3));
+  const auto div6 = select(flat, [](std::size_t i){return i % 6 == 0;});
+  ASSERT_EQ(div6, even & div3);
+  const auto all = select(flat, [](std::size_t){return true;});
+  ASSERT_EQ(64u, all.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(parallel_test, hierarchical_operations)
+{
+  const auto even = select(hier, [](std::size_t i){return i % 2 == 0;});
+  const auto div3 = select(hier, [](std::size_t i){return i % 3 == 0;});
+  ASSERT_EQ(32u, even.size());
+  ASSERT_EQ(22u, div3.size());
+  ASSERT_EQ(43u, (even + div3).size());
+  ASSERT_EQ(11u, (even & div3).size());
+  ASSERT_EQ(21u, (even - div3).size());
+  ASSERT_EQ(even, (even - div3) + (even & div3));
+  const auto div6 = select(hier, [](std::size_t i){return i % 6 == 0;});
+  ASSERT_EQ(div6, even & div3);
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,178 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/conf/default_configurations.hh"
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+#include "sdd/tools/nodes.hh"
+#include "sdd/tools/size.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct split_alpha_conf
+  : public sdd::conf1
+{
+  static constexpr bool split_alpha = true;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct increment
+{
+  bool
+  selector()
+  const noexcept
+  {
+    return false;
+  }
+
+  split_alpha_conf::Values
+  operator()(const split_alpha_conf::Values& val)
+  const
+  {
+    split_alpha_conf::Values res;
+    for (const auto v : val)
+    {
+      if (v < 4)
+      {
+        res.insert(v + 1);
+      }
+    }
+    return res;
+  }
+
+  friend
+  bool
+  operator==(const increment&, const increment&)
+  noexcept
+  {
+    return true;
+  }
+};
+
+namespace std {
+
+template <>
+struct hash<increment>
+{
+  std::size_t
+  operator()(const increment&)
+  const noexcept
+  {
+    return 0;
+  }
+};
+
+} // namespace std
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct split_alpha_test
+  : public testing::Test
+{
+  using conf        = split_alpha_conf;
+  using SDD         = sdd::SDD<conf>;
+  using values_type = conf::Values;
+
+  sdd::manager<conf> m;
+  sdd::dd::context<conf>& cxt;
+
+  const SDD zero;
+  const SDD one;
+
+  split_alpha_test()
+    : m(sdd::init(small_conf<conf>()))
+    , cxt(sdd::global<conf>().sdd_context)
+    , zero(sdd::zero<conf>())
+    , one(sdd::one<conf>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(split_alpha_test, layout)
+{
+  using node_type = sdd::flat_node<conf>;
+  static_assert( std::is_same< node_type::alpha_layout
+                             , sdd::dd::split_layout<conf, values_type>>::value
+               , "Unexpected layout");
+  ASSERT_EQ( 3 * (sizeof(SDD) + sizeof(values_type))
+           , node_type::alpha_layout::size_to_allocate(3));
+
+  const SDD x = SDD(0, {0}, SDD(1, {0}, one))
+              + SDD(0, {1}, SDD(1, {1}, one))
+              + SDD(0, {2}, SDD(1, {2}, one));
+  const auto& n = sdd::mem::variant_cast<node_type>(*x);
+  ASSERT_EQ(3u, n.size());
+  ASSERT_EQ(3, std::distance(n.begin(), n.end()));
+
+  std::vector<values_type> valuations;
+  for (const auto& arc : n)
+  {
+    valuations.push_back(arc.valuation());
+    ASSERT_EQ(SDD(1, arc.valuation(), one), arc.successor());
+  }
+  ASSERT_EQ(valuations.size(), 3u);
+  ASSERT_EQ((n.end() - 1)->valuation(), valuations.back());
+  ASSERT_EQ(n.begin()[1].successor(), (n.begin() + 1)->successor());
+
+  // Nodes are unified with the same hash whatever their layout.
+  ASSERT_EQ(x, SDD(0, {2}, SDD(1, {2}, one))
+             + SDD(0, {0}, SDD(1, {0}, one))
+             + SDD(0, {1}, SDD(1, {1}, one)));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(split_alpha_test, flat_operations)
+{
+  const SDD x = SDD(0, {0,1}, SDD(1, {0}, one)) + SDD(0, {2,3}, SDD(1, {1}, one));
+  const SDD y = SDD(0, {1,2}, SDD(1, {0,1}, one));
+
+  ASSERT_EQ( SDD(0, {0}, SDD(1, {0}, one)) + SDD(0, {1,2}, SDD(1, {0,1}, one))
+           + SDD(0, {3}, SDD(1, {1}, one))
+           , x + y);
+  ASSERT_EQ(SDD(0, {1}, SDD(1, {0}, one)) + SDD(0, {2}, SDD(1, {1}, one)), x & y);
+  ASSERT_EQ(SDD(0, {0}, SDD(1, {0}, one)) + SDD(0, {3}, SDD(1, {1}, one)), x - y);
+  ASSERT_EQ(SDD(0, {1}, SDD(1, {1}, one)) + SDD(0, {2}, SDD(1, {0}, one)), y - x);
+  ASSERT_EQ(6u, (x + y).size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(split_alpha_test, hierarchical_operations)
+{
+  const SDD a(0, {0}, one);
+  const SDD b(0, {1}, one);
+  const SDD x = SDD(1, a, SDD(0, {0}, one)) + SDD(1, b, SDD(0, {1}, one));
+  const SDD y = SDD(1, a + b, SDD(0, {0}, one));
+
+  ASSERT_EQ(SDD(1, a, SDD(0, {0}, one)), x & y);
+  ASSERT_EQ(SDD(1, b, SDD(0, {1}, one)), x - y);
+  ASSERT_EQ(3u, (x + y).size());
+  ASSERT_EQ(std::make_pair(1u, 1u), sdd::tools::nodes(SDD(1, a, one)));
+  ASSERT_LT(0u, sdd::tools::size(x + y));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(split_alpha_test, homomorphism)
+{
+  const sdd::order<conf> o(sdd::order_builder<conf>({"a", "b"}));
+  const SDD x(o, [](const std::string&){return values_type{0,1};});
+  const auto h = sdd::fixpoint(sdd::sum(o, {sdd::id<conf>(), sdd::function(o, "a", increment())}));
+  const SDD expected(o, [](const std::string& id)
+                        {
+                          return id == "a" ? values_type{0,1,2,3,4} : values_type{0,1};
+                        });
+  ASSERT_EQ(expected, h(o, x));
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -227,6 +227,41 @@ TYPED_TEST(sum_test, hierarchical_partition_changing)
 
 /*------------------------------------------------------------------------------------------------*/
 
+TYPED_TEST(sum_test, hierarchical_several_arcs)
+{
+  const auto y = [&](const values_type& v){return SDD('y', SDD('b', v, one), one);};
+
+  hier_alpha_builder builder0(cxt);
+  builder0.add(SDD('a', {0,1,2}, one), y({0}));
+  builder0.add(SDD('a', {3,4}, one), y({1}));
+  const SDD x0('x', std::move(builder0));
+
+  hier_alpha_builder builder1(cxt);
+  builder1.add(SDD('a', {1,3}, one), y({2}));
+  builder1.add(SDD('a', {4,5}, one), y({0}));
+  const SDD x1('x', std::move(builder1));
+
+  hier_alpha_builder builder2(cxt);
+  builder2.add(SDD('a', {0,1,2}, one), y({1}));
+  builder2.add(SDD('a', {3,4,5,6}, one), y({2}));
+  const SDD x2('x', std::move(builder2));
+
+  hier_alpha_builder builder(cxt);
+  builder.add(SDD('a', {0,2}, one), y({0,1}));
+  builder.add(SDD('a', {1,4}, one), y({0,1,2}));
+  builder.add(SDD('a', {3}, one), y({1,2}));
+  builder.add(SDD('a', {5}, one), y({0,2}));
+  builder.add(SDD('a', {6}, one), y({2}));
+  const SDD ref('x', std::move(builder));
+
+  ASSERT_EQ(ref, sum(cxt, {cxt, {x0, x1, x2}}));
+  ASSERT_EQ(ref, sum(cxt, {cxt, {x2, x0, x1}}));
+  ASSERT_EQ(ref, sum(cxt, {cxt, {sum(cxt, {cxt, {x0, x1}}), x2}}));
+  ASSERT_EQ(ref, x0 + x1 + x2);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
 TYPED_TEST(sum_test, values)
 {
   {
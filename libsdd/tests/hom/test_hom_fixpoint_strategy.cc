@@ -0,0 +1,116 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/hom/rewrite.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+
+#include "tests/configuration.hh"
+#include "tests/hom/common.hh"
+#include "tests/hom/common_inductives.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct hom_fixpoint_strategy_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  /// @brief Compute a state space with a given strategy.
+  ///
+  /// The manager is created for each call, thus no result is shared between strategies.
+  static
+  auto
+  state_space(sdd::fixpoint_strategy strategy, bool saturation)
+  {
+    auto c = small_conf<C>();
+    c.hom_fixpoint_strategy = strategy;
+    auto m = sdd::init(c);
+
+    const sdd::order<C> o(sdd::order_builder<C>().push("c")
+                                                 .push("b", sdd::order_builder<C>{"x", "y"})
+                                                 .push("a"));
+    const sdd::SDD<C> s0(o, [](const auto&){return typename C::Values{0};});
+    const auto incr = [&](const std::string& var, unsigned int n)
+    {
+      return sdd::inductive<C>(targeted_incr<C>(var, n));
+    };
+    auto h = fixpoint(sum<C>(o, { incr("a", 1), incr("c", 2)
+                                , local("b", o, sum<C>(o, {incr("x", 1), incr("y", 1)}))
+                                , sdd::id<C>()}));
+    if (saturation)
+    {
+      h = sdd::rewrite(o, h);
+    }
+    const auto size = h(o, s0).size();
+    return std::make_pair(size, m.hom_fixpoint_stats());
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(hom_fixpoint_strategy_test, configurations);
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_fixpoint_strategy_test, same_state_space)
+{
+  for (const bool saturation : {false, true})
+  {
+    const auto reference
+      = TestFixture::state_space(sdd::fixpoint_strategy::accumulate, saturation).first;
+    ASSERT_LT(1u, reference);
+    for (const auto strategy : {sdd::fixpoint_strategy::frontier, sdd::fixpoint_strategy::chaining})
+    {
+      ASSERT_EQ(reference, TestFixture::state_space(strategy, saturation).first);
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_fixpoint_strategy_test, statistics)
+{
+  for (const auto strategy : { sdd::fixpoint_strategy::accumulate
+                             , sdd::fixpoint_strategy::frontier
+                             , sdd::fixpoint_strategy::chaining})
+  {
+    for (const bool saturation : {false, true})
+    {
+      const auto stats = TestFixture::state_space(strategy, saturation).second;
+      ASSERT_LT(0u, stats.evaluations);
+      ASSERT_LT(1u, stats.iterations.size());
+      // Each evaluation performs at least one iteration.
+      ASSERT_EQ(stats.evaluations, stats.iterations.front().count);
+      for (std::size_t i = 1; i < stats.iterations.size(); ++i)
+      {
+        ASSERT_LE(stats.iterations[i].count, stats.iterations[i - 1].count);
+        ASSERT_LT(0u, stats.iterations[i].applications);
+      }
+    }
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_fixpoint_strategy_test, frontier_needs_id)
+{
+  using C = TypeParam;
+  auto c = small_conf<C>();
+  c.hom_fixpoint_strategy = sdd::fixpoint_strategy::frontier;
+  auto m = sdd::init(c);
+
+  // Without Id, the fixpoint doesn't compute reachable states: it's evaluated as usual. The union
+  // of all iterations would contain 0.
+  const sdd::order<C> o(sdd::order_builder<C>({"a"}));
+  const sdd::SDD<C> s0(0, {0, 1}, sdd::one<C>());
+  const auto h = fixpoint(sum<C>(o, { sdd::inductive<C>(targeted_incr<C>("a", 1))
+                                    , sdd::inductive<C>(targeted_incr<C>("a", 2))}));
+  ASSERT_EQ(sdd::SDD<C>(0, {1, 2, 3}, sdd::one<C>()), h(o, s0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
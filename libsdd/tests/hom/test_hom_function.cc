@@ -1,4 +1,7 @@
+#include <algorithm> // copy
 #include <limits>
+#include <memory>    // make_shared, shared_ptr
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -96,8 +99,74 @@ operator<<(std::ostream& os, const threshold_fun<C, Selector>& f)
 
 /*------------------------------------------------------------------------------------------------*/
 
+/// @brief Record the number of values given to each call of an identity function.
+template <typename C>
+struct counted_id
+{
+  using values_type = typename C::Values;
+
+  const std::shared_ptr<std::vector<std::size_t>> calls
+    = std::make_shared<std::vector<std::size_t>>();
+
+  values_type
+  operator()(const values_type& val)
+  const
+  {
+    calls->push_back(1);
+    return val;
+  }
+
+  bool
+  operator==(const counted_id& other)
+  const noexcept
+  {
+    return calls == other.calls;
+  }
+};
+
+/// @brief An identity function which handles all valuations of a node at once.
+template <typename C>
+struct bulk_counted_id
+  : public counted_id<C>
+{
+  using values_type = typename C::Values;
+  using counted_id<C>::operator();
+
+  void
+  operator()(const values_type* begin, const values_type* end, values_type* images)
+  const
+  {
+    this->calls->push_back(end - begin);
+    std::copy(begin, end, images);
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
 namespace std {
 
+template <typename C>
+struct hash<counted_id<C>>
+{
+  std::size_t
+  operator()(const counted_id<C>& f)
+  const noexcept
+  {
+    return std::hash<std::vector<std::size_t>*>()(f.calls.get());
+  }
+};
+
+template <typename C>
+struct hash<bulk_counted_id<C>>
+{
+  std::size_t
+  operator()(const bulk_counted_id<C>& f)
+  const noexcept
+  {
+    return std::hash<std::vector<std::size_t>*>()(f.calls.get());
+  }
+};
+
 template <typename C, bool Selector>
 struct hash<threshold_fun<C, Selector>>
 {
@@ -240,3 +309,40 @@ TYPED_TEST(hom_function_test, evaluation_no_selector)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_function_test, cache)
+{
+  const order o(order_builder {"a", "b", "c"});
+  // Three nodes for b, two of them with the same valuation.
+  const SDD s0 = SDD(2, {0}, SDD(1, {0}, SDD(0, {0}, one)))
+               + SDD(2, {1}, SDD(1, {0}, SDD(0, {1}, one)))
+               + SDD(2, {2}, SDD(1, {1}, SDD(0, {2}, one)));
+  counted_id<conf> fun;
+  const auto calls = fun.calls;
+  const auto h0 = function<conf>(o, "b", std::move(fun));
+  ASSERT_EQ(s0, h0(o, s0));
+  ASSERT_EQ(2u, calls->size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_function_test, bulk)
+{
+  const order o(order_builder {"a", "b"});
+  bulk_counted_id<conf> fun;
+  const auto calls = fun.calls;
+  const auto h0 = function<conf>(o, "a", std::move(fun));
+  {
+    const SDD s0 = SDD(1, {0}, SDD(0, {0}, one)) + SDD(1, {1}, SDD(0, {1}, one));
+    ASSERT_EQ(s0, h0(o, s0));
+    ASSERT_EQ(std::vector<std::size_t>({2}), *calls);
+  }
+  {
+    // The image of {0} is in the cache.
+    const SDD s0 = SDD(1, {0}, SDD(0, {2}, one)) + SDD(1, {2}, SDD(0, {3}, one));
+    ASSERT_EQ(s0, h0(o, s0));
+    ASSERT_EQ(std::vector<std::size_t>({2, 1}), *calls);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,68 @@
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/hom/rewrite.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+
+#include "tests/configuration.hh"
+#include "tests/hom/common.hh"
+#include "tests/hom/common_inductives.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct hom_parallel_test
+  : public testing::Test
+{
+  using conf          = parallel_conf;
+  using SDD           = sdd::SDD<conf>;
+  using homomorphism  = sdd::homomorphism<conf>;
+  using order         = sdd::order<conf>;
+  using order_builder = sdd::order_builder<conf>;
+  using values        = sdd::values::bitset<64>;
+
+  sdd::manager<conf> m;
+
+  hom_parallel_test()
+    : m(sdd::init(small_parallel_conf()))
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(hom_parallel_test, saturation)
+{
+  order_builder ob;
+  for (const auto& i : {"2", "1", "0"})
+  {
+    ob.push(std::string("x") + i, order_builder {std::string("a") + i, std::string("b") + i});
+  }
+  const order o(ob);
+  const SDD s0(o, [](const std::string&){return values {0};});
+
+  std::vector<homomorphism> events {sdd::id<conf>()};
+  for (const auto& i : {"0", "1", "2"})
+  {
+    const auto x = std::string("x") + i;
+    const auto a = std::string("a") + i;
+    const auto b = std::string("b") + i;
+    // Two events on the same variable, which are applied concurrently by the saturation.
+    events.push_back(local(x, o, inductive<conf>(targeted_incr<conf>(a, 1))));
+    events.push_back(local(x, o, inductive<conf>(targeted_incr<conf>(a, 2))));
+    events.push_back(local(x, o, inductive<conf>(targeted_incr<conf>(b, 1))));
+  }
+  const auto h0 = fixpoint(sum(o, events.begin(), events.end()));
+  const auto h1 = sdd::rewrite(o, h0);
+  ASSERT_NE(h0, h1);
+
+  const auto s1 = h1(o, s0);
+  ASSERT_EQ(h0(o, s0), s1);
+  // Each a_i and b_i can take the values 0, 1 and 2.
+  ASSERT_EQ(729u, s1.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
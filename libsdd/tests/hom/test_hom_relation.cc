@@ -0,0 +1,183 @@
+#include <stdexcept> // invalid_argument
+
+#include "gtest/gtest.h"
+
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/hom/rewrite.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+
+#include "tests/configuration.hh"
+#include "tests/hom/common.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename C>
+struct hom_relation_test
+  : public testing::Test
+{
+  using configuration_type = C;
+
+  sdd::manager<C> m;
+
+  const sdd::SDD<C> zero;
+  const sdd::SDD<C> one;
+  const sdd::homomorphism<C> id;
+
+  hom_relation_test()
+    : m(sdd::init(small_conf<C>()))
+    , zero(sdd::zero<C>())
+    , one(sdd::one<C>())
+    , id(sdd::id<C>())
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST_CASE(hom_relation_test, configurations);
+#include "tests/macros.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_relation_test, construction)
+{
+  const order o(order_builder {"a", "b"});
+  {
+    const auto h1 = sdd::relation<conf>(o, {{"a", {{0, {1}}}}});
+    const auto h2 = sdd::relation<conf>(o, {{"a", {{0, {1}}}}});
+    ASSERT_EQ(h1, h2);
+  }
+  {
+    const auto h1 = sdd::relation<conf>(o, {{"a", {{0, {1}}}}});
+    const auto h2 = sdd::relation<conf>(o, {{"a", {{0, {2}}}}});
+    ASSERT_NE(h1, h2);
+  }
+  {
+    const auto h1 = sdd::relation<conf>(o, {{"a", {{0, {1}}}}});
+    const auto h2 = sdd::relation<conf>(o, {{"b", {{0, {1}}}}});
+    ASSERT_NE(h1, h2);
+  }
+  {
+    // Empty updates are dropped.
+    const auto h1 = sdd::relation<conf>(o, {{"a", {{0, {1}}, {1, {}}}}});
+    const auto h2 = sdd::relation<conf>(o, {{"a", {{0, {1}}}}});
+    ASSERT_EQ(h1, h2);
+  }
+  {
+    ASSERT_EQ(id, sdd::relation<conf>(o, {}));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_relation_test, selector)
+{
+  const order o(order_builder {"a", "b"});
+  ASSERT_TRUE(sdd::relation<conf>(o, {{"a", {{0, {0}}, {2, {2}}}}}).selector());
+  ASSERT_TRUE(sdd::relation<conf>(o, {{"a", {{0, {0}}}}, {"b", {{1, {1}}}}}).selector());
+  ASSERT_FALSE(sdd::relation<conf>(o, {{"a", {{0, {0}}}}, {"b", {{1, {2}}}}}).selector());
+  ASSERT_FALSE(sdd::relation<conf>(o, {{"a", {{0, {0, 1}}}}}).selector());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_relation_test, evaluation_flat)
+{
+  const order o(order_builder {"a", "b", "c"});
+  const SDD s0(o, [](const std::string& name) -> values_type
+                    {
+                      if (name == "a") return {0, 1};
+                      return {0};
+                    });
+  {
+    const auto h = sdd::relation<conf>(o, {{"a", {{0, {2, 3}}}}, {"c", {{0, {1}}}}});
+    const SDD expected(o, [](const std::string& name) -> values_type
+                            {
+                              if (name == "a") return {2, 3};
+                              if (name == "b") return {0};
+                              return {1};
+                            });
+    ASSERT_EQ(expected, h(o, s0));
+  }
+  {
+    // Each value of a is updated independently.
+    const auto h = sdd::relation<conf>(o, {{"a", {{0, {5}}, {1, {6}}}}});
+    const SDD expected(o, [](const std::string& name) -> values_type
+                            {
+                              if (name == "a") return {5, 6};
+                              return {0};
+                            });
+    ASSERT_EQ(expected, h(o, s0));
+  }
+  {
+    // The relation is disabled by values of c.
+    const auto h = sdd::relation<conf>(o, {{"a", {{0, {5}}}}, {"c", {{1, {2}}}}});
+    ASSERT_EQ(zero, h(o, s0));
+  }
+  {
+    // A guard.
+    const auto h = sdd::relation<conf>(o, {{"a", {{1, {1}}}}});
+    const SDD expected(o, [](const std::string& name) -> values_type
+                            {
+                              if (name == "a") return {1};
+                              return {0};
+                            });
+    ASSERT_EQ(expected, h(o, s0));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_relation_test, evaluation_hierarchical)
+{
+  const order o(order_builder().push("c").push("b", order_builder {"x", "y"}).push("a"));
+  const SDD s0(o, [](const std::string&) -> values_type {return {0};});
+  {
+    const auto h = sdd::relation<conf>(o, {{"y", {{0, {1}}}}, {"a", {{0, {2}}}}});
+    const SDD expected(o, [](const std::string& name) -> values_type
+                            {
+                              if (name == "y") return {1};
+                              if (name == "a") return {2};
+                              return {0};
+                            });
+    ASSERT_EQ(expected, h(o, s0));
+  }
+  {
+    // A relation can't update a hierarchical identifier.
+    ASSERT_THROW(sdd::relation<conf>(o, {{"b", {{0, {1}}}}}), std::invalid_argument);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_relation_test, saturation)
+{
+  const order o(order_builder().push("c").push("b", order_builder {"x", "y"}).push("a"));
+  const SDD s0(o, [](const std::string&) -> values_type {return {0};});
+  const auto h = fixpoint(sum<conf>(o, { sdd::relation<conf>(o, {{"a", {{0, {1}}}}})
+                                       , sdd::relation<conf>(o, {{"a", {{1, {2}}}}})
+                                       , sdd::relation<conf>(o, {{"x", {{0, {1}}, {1, {2}}}}})
+                                       , sdd::relation<conf>( o, { {"y", {{0, {1}}}}
+                                                                 , {"c", {{0, {1}}}}})
+                                       , id}));
+  const auto rewritten = sdd::rewrite(o, h);
+  ASSERT_NE(h, rewritten);
+  ASSERT_EQ(h(o, s0), rewritten(o, s0));
+  ASSERT_EQ(18u, h(o, s0).size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(hom_relation_test, rewrite_clusters_relations)
+{
+  const order o(order_builder {"a", "b"});
+  const auto h1 = fixpoint(sum<conf>(o, { sdd::relation<conf>(o, {{"a", {{0, {1}}}}})
+                                        , sdd::relation<conf>(o, {{"a", {{0, {2}}, {1, {2}}}}})
+                                        , id}));
+  const auto h2 = fixpoint(sum<conf>(o, { sdd::relation<conf>(o, {{"a", {{0, {1, 2}}, {1, {2}}}}})
+                                        , id}));
+  ASSERT_EQ(sdd::rewrite(o, h2), sdd::rewrite(o, h1));
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,128 @@
+#include <functional> // hash
+
+#include "gtest/gtest.h"
+
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+
+#include "tests/configuration.hh"
+#include "tests/hom/common.hh"
+#include "tests/hom/common_inductives.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief Keep values strictly below a bound.
+template <typename C>
+struct keep_below
+{
+  using values_type = typename C::Values;
+
+  const unsigned int bound_;
+
+  values_type
+  operator()(const values_type& val)
+  const
+  {
+    values_type new_val;
+    for (const auto& v : val)
+    {
+      if (v < bound_)
+      {
+        new_val.insert(v);
+      }
+    }
+    return new_val;
+  }
+
+  bool
+  operator==(const keep_below& other)
+  const noexcept
+  {
+    return bound_ == other.bound_;
+  }
+};
+
+namespace std {
+
+template <typename C>
+struct hash<keep_below<C>>
+{
+  std::size_t
+  operator()(const keep_below<C>& f)
+  const noexcept
+  {
+    return std::hash<unsigned int>()(f.bound_);
+  }
+};
+
+} // namespace std
+
+/*------------------------------------------------------------------------------------------------*/
+
+/// @brief A configuration which knows some user's types at compile time.
+struct static_conf
+  : public sdd::conf1
+{
+  using inductive_types = sdd::util::list<targeted_incr<static_conf>>;
+  using function_types  = sdd::util::list<keep_below<static_conf>>;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct hom_static_types_test
+  : public testing::Test
+{
+  using conf          = static_conf;
+  using SDD           = sdd::SDD<conf>;
+  using homomorphism  = sdd::homomorphism<conf>;
+  using order         = sdd::order<conf>;
+  using order_builder = sdd::order_builder<conf>;
+
+  sdd::manager<conf> m;
+
+  hom_static_types_test()
+    : m(sdd::init(small_conf<conf>()))
+  {}
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(hom_static_types_test, inductive)
+{
+  const order o(order_builder {"a", "b"});
+  const auto h0 = sdd::inductive<conf>(targeted_incr<conf>("b", 1));
+  ASSERT_TRUE((sdd::mem::is<sdd::hom::_static_inductive<conf, targeted_incr<conf>>>(h0)));
+  ASSERT_EQ(h0, sdd::inductive<conf>(targeted_incr<conf>("b", 1)));
+  ASSERT_NE(h0, sdd::inductive<conf>(targeted_incr<conf>("b", 2)));
+  ASSERT_NE(h0, sdd::inductive<conf>(targeted_incr<conf>("a", 1)));
+
+  const SDD s0(1, {0}, SDD(0, {0}, sdd::one<conf>()));
+  ASSERT_EQ(SDD(1, {0}, SDD(0, {1}, sdd::one<conf>())), h0(o, s0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(hom_static_types_test, inductive_not_listed)
+{
+  const auto h = sdd::inductive<conf>(targeted_noop<conf>("a"));
+  ASSERT_TRUE(sdd::mem::is<sdd::hom::_inductive<conf>>(h));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(hom_static_types_test, function)
+{
+  const order o(order_builder {"a", "b"});
+  const auto h0 = sdd::function(o, "b", keep_below<conf>{2});
+  ASSERT_TRUE((sdd::mem::is<sdd::hom::_static_function<conf, keep_below<conf>>>(h0)));
+  ASSERT_EQ(h0, sdd::function(o, "b", keep_below<conf>{2}));
+  ASSERT_NE(h0, sdd::function(o, "b", keep_below<conf>{3}));
+  ASSERT_NE(h0, sdd::function(o, "a", keep_below<conf>{2}));
+
+  const SDD s0(1, {0}, SDD(0, {0, 1, 2}, sdd::one<conf>()));
+  ASSERT_EQ(SDD(1, {0}, SDD(0, {0, 1}, sdd::one<conf>())), h0(o, s0));
+}
+
+/*------------------------------------------------------------------------------------------------*/
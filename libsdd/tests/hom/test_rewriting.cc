@@ -176,3 +176,60 @@ TYPED_TEST(rewriting_test, transitive_closure)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(rewriting_test, composition)
+{
+  using ob = order_builder;
+  const auto ib = inductive<conf>(targeted_incr<conf>("b", 1));
+  const auto ix0 = inductive<conf>(targeted_incr<conf>("x", 0));
+  const auto ix1 = inductive<conf>(targeted_incr<conf>("x", 1));
+  {
+    // Locals on the same variable are merged through operands which skip this variable.
+    const order o(ob("a", ob {"x"}) << ob("b"));
+    const homomorphism h0 = composition(local("a", o, ix1), composition(ib, local("a", o, ix0)));
+    const homomorphism h1 = sdd::rewrite(o, h0);
+    ASSERT_NE(h1, h0);
+    ASSERT_EQ(composition(local("a", o, composition(ix1, ix0)), ib), h1);
+    SDD s0(1, SDD(0, {0}, one), SDD(0, {0}, one));
+    ASSERT_EQ(h0(o, s0), h1(o, s0));
+  }
+  {
+    // Operands of a composition are saturated.
+    const order o(ob("a", ob {"x"}) << ob("b"));
+    const homomorphism h0 = composition( ib
+                                       , fixpoint(sum<conf>( o
+                                                           , { id, ib
+                                                             , local("a", o, ix1)})));
+    const homomorphism h1 = sdd::rewrite(o, h0);
+    ASSERT_NE(h1, h0);
+    SDD s0(1, SDD(0, {0}, one), SDD(0, {0}, one));
+    ASSERT_EQ(h0(o, s0), h1(o, s0));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(rewriting_test, if_then_else)
+{
+  using ob = order_builder;
+  const order o(ob("a", ob {"x"}) << ob("b"));
+  const auto ib = inductive<conf>(targeted_incr<conf>("b", 1));
+  const auto lx = local("a", o, inductive<conf>(targeted_incr<conf>("x", 1)));
+  const auto pred = sdd::relation<conf>(o, {{"b", {{0, {0}}}}});
+  SDD s0(1, SDD(0, {0}, one), SDD(0, {0, 1}, one));
+  {
+    // The common part of both branches is factored, the predicate is then evaluated on b only.
+    const homomorphism h0 = sdd::if_then_else(pred, composition(lx, ib), lx);
+    const homomorphism h1 = sdd::rewrite(o, h0);
+    ASSERT_NE(h1, h0);
+    ASSERT_EQ(composition(lx, sdd::if_then_else(pred, ib, id)), h1);
+    ASSERT_EQ(h0(o, s0), h1(o, s0));
+  }
+  {
+    // Nothing to factor.
+    const homomorphism h0 = sdd::if_then_else(pred, ib, lx);
+    ASSERT_EQ(h0, sdd::rewrite(o, h0));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
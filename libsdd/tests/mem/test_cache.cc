@@ -1,8 +1,11 @@
 #include "gtest/gtest.h"
 
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include "sdd/mem/cache.hh"
+#include "sdd/mem/concurrent_cache.hh"
 
 using namespace sdd::mem;
 
@@ -316,3 +319,133 @@ TEST(cache, exception)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+template <typename Cache>
+void
+check_eviction(Cache& c)
+{
+  const auto& stats = c.statistics();
+
+  // Fill the cache until the first eviction, which discards operation(0).
+  std::size_t i = 0;
+  for (; stats.discarded == 0; ++i)
+  {
+    ASSERT_EQ(i + 1, c(operation(i)));
+  }
+  ASSERT_EQ(i, c.size() + 1);
+
+  // operation(1) is the oldest entry, access it so that operation(2) is discarded instead.
+  const auto hits = stats.hits;
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(hits + 1, stats.hits);
+  ASSERT_EQ(i + 1, c(operation(i)));
+  ASSERT_EQ(2u, stats.discarded);
+
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(hits + 2, stats.hits);
+  const auto misses = stats.misses;
+  ASSERT_EQ(3u, c(operation(2)));
+  ASSERT_EQ(misses + 1, stats.misses);
+}
+
+TEST(cache, eviction)
+{
+  {
+    basic_cache<context, operation, lru_eviction> c(cxt, 100);
+    check_eviction(c);
+  }
+  {
+    basic_cache<context, operation, clock_eviction> c(cxt, 100);
+    check_eviction(c);
+  }
+  {
+    basic_cache<context, operation, clock_eviction> c(cxt, 100);
+    check_eviction(c);
+    c.clear();
+    ASSERT_EQ(0u, c.size());
+    ASSERT_EQ(2u, c(operation(1)));
+    ASSERT_EQ(2u, c(operation(1)));
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(concurrent_cache, insertion)
+{
+  concurrent_cache<context, operation> c(cxt, 100);
+
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(0u, c.statistics().hits);
+  ASSERT_EQ(1u, c.statistics().misses);
+  ASSERT_EQ(1u, c.statistics().size);
+
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(1u, c.statistics().hits);
+  ASSERT_EQ(1u, c.statistics().misses);
+
+  ASSERT_EQ(3u, c(cxt, operation(2)));
+  ASSERT_EQ(1u, c.statistics().hits);
+  ASSERT_EQ(2u, c.statistics().misses);
+  ASSERT_EQ(2u, c.statistics().size);
+
+  // 1 and 129 share the same slot.
+  ASSERT_EQ(130u, c(operation(129)));
+  ASSERT_EQ(3u, c.statistics().misses);
+  ASSERT_EQ(1u, c.statistics().discarded);
+  ASSERT_EQ(2u, c.statistics().size);
+
+  ASSERT_EQ(2u, c(operation(1)));
+  ASSERT_EQ(1u, c.statistics().hits);
+  ASSERT_EQ(4u, c.statistics().misses);
+
+  c.clear();
+  ASSERT_EQ(0u, c.statistics().size);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(concurrent_cache, filters_and_exception)
+{
+  concurrent_cache<context, operation, filter_0> c(cxt, 100);
+
+  ASSERT_EQ(1u, c(operation(0)));
+  ASSERT_EQ(1u, c(operation(0)));
+  ASSERT_EQ(0u, c.statistics().hits);
+  ASSERT_EQ(0u, c.statistics().misses);
+  ASSERT_EQ(2u, c.statistics().filtered);
+
+  ASSERT_THROW(c(operation(6666)), std::runtime_error);
+  ASSERT_EQ(0u, c.statistics().size);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(concurrent_cache, threads)
+{
+  concurrent_cache<context, operation> c(cxt, 64);
+  std::vector<std::thread> threads;
+  std::vector<bool> ok(4, true);
+  for (std::size_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&, t]
+    {
+      for (std::size_t i = 0; i < 10000; ++i)
+      {
+        if (c(operation((i * (t + 1)) % 512)) != (i * (t + 1)) % 512 + 1)
+        {
+          ok[t] = false;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  ASSERT_EQ(std::vector<bool>(4, true), ok);
+  const auto& stats = c.statistics();
+  ASSERT_EQ(40000u, stats.hits + stats.misses);
+  ASSERT_GE(64u, stats.size);
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -105,6 +105,7 @@ struct hash<bar>
 using foo_hash_table = hash_table<foo>;
 using foo_fixed_hash_table = hash_table<foo, false>;
 using bar_hash_table = hash_table<bar>;
+using foo_incremental_hash_table = hash_table<foo, true, true>;
 
 /*------------------------------------------------------------------------------------------------*/
 
@@ -296,3 +297,76 @@ TEST(hash_table, clear_and_dispose)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TEST(hash_table, incremental_rehash)
+{
+  std::vector<foo> vec;
+  vec.reserve(100);
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    vec.push_back(foo{i});
+  }
+
+  foo_incremental_hash_table ht{8};
+  bool migrated = false;
+  for (auto& f : vec)
+  {
+    ASSERT_TRUE(ht.insert(&f).second);
+    if (ht.migrating())
+    {
+      migrated = true;
+      // Elements of buckets not migrated yet must still be found.
+      for (auto& g : vec)
+      {
+        foo copy{g.data};
+        const auto insertion = ht.insert(&copy);
+        if (&g <= &f)
+        {
+          ASSERT_FALSE(insertion.second);
+          ASSERT_EQ(&g, insertion.first);
+        }
+        else
+        {
+          ASSERT_TRUE(insertion.second);
+          ht.erase(&copy);
+        }
+      }
+    }
+  }
+  ASSERT_TRUE(migrated);
+  ASSERT_EQ(100u, ht.size());
+  ASSERT_LT(0u, ht.nb_rehash());
+
+  for (auto& f : vec)
+  {
+    ht.erase(&f);
+  }
+  ASSERT_EQ(0u, ht.size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(hash_table, incremental_rehash_clear_and_dispose)
+{
+  std::vector<foo> vec;
+  vec.reserve(7);
+  for (unsigned int i = 0; i < 7; ++i)
+  {
+    vec.push_back(foo{i});
+  }
+
+  foo_incremental_hash_table ht{8};
+  for (auto& f : vec)
+  {
+    ht.insert(&f);
+  }
+  ASSERT_TRUE(ht.migrating());
+
+  std::size_t cpt = 0;
+  ht.clear_and_dispose([&cpt](foo*){++cpt;});
+  ASSERT_FALSE(ht.migrating());
+  ASSERT_EQ(0u, ht.size());
+  ASSERT_EQ(7u, cpt);
+}
+
+/*------------------------------------------------------------------------------------------------*/
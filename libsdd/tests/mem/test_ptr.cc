@@ -21,10 +21,10 @@ struct unique
     ++ref_counter_;
   }
   
-  void
+  bool
   decrement_reference_counter()
   {
-    --ref_counter_;
+    return --ref_counter_ == 0;
   }
 
   bool
@@ -88,12 +88,12 @@ struct ptr_test
     : table_()
   {
     table_.reset();
-    sdd::mem::set_deletion_handler<unique>([&](const unique* u){table_.erase(u);});
+    sdd::mem::set_deletion_table(table_);
   }
 
   ~ptr_test()
   {
-    sdd::mem::reset_deletion_handler<unique>();
+    sdd::mem::reset_deletion_table<sdd::mem::unique_table<unique>>();
   }
 };
 
@@ -0,0 +1,70 @@
+#include <cstdint> // uintptr_t
+#include <cstring> // memset
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/mem/slab_allocator.hh"
+
+using namespace sdd::mem;
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(slab_allocator, reuse)
+{
+  slab_allocator a;
+
+  char* p0 = a.allocate(24);
+  char* p1 = a.allocate(24);
+  ASSERT_NE(p0, p1);
+  ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(p0) % slab_allocator::alignment);
+  ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(p1) % slab_allocator::alignment);
+
+  // A released block is reused by an allocation of the same size class.
+  a.deallocate(p0);
+  ASSERT_EQ(p0, a.allocate(20));
+
+  // But not by an allocation of another size class.
+  a.deallocate(p1);
+  char* p2 = a.allocate(64);
+  ASSERT_NE(p1, p2);
+  ASSERT_EQ(p1, a.allocate(24));
+  ASSERT_EQ(1u, a.nb_chunks());
+
+  a.deallocate(p0);
+  a.deallocate(p1);
+  a.deallocate(p2);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(slab_allocator, chunks)
+{
+  slab_allocator a(8192);
+  std::vector<char*> blocks;
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    const auto size = 1 + (i * 37) % 512;
+    blocks.push_back(a.allocate(size));
+    std::memset(blocks.back(), static_cast<int>(i), size);
+  }
+  ASSERT_LT(1u, a.nb_chunks());
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    ASSERT_EQ(static_cast<char>(i), blocks[i][(i * 37) % 512]);
+    a.deallocate(blocks[i]);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(slab_allocator, large_blocks)
+{
+  slab_allocator a;
+  char* p = a.allocate(slab_allocator::max_small_size + 1);
+  std::memset(p, 0, slab_allocator::max_small_size + 1);
+  ASSERT_EQ(0u, a.nb_chunks());
+  a.deallocate(p);
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -1,6 +1,12 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "sdd/mem/hash_table.hh"
+#include "sdd/mem/sharded_unique_table.hh"
+#include "sdd/mem/unique.hh"
 #include "sdd/mem/unique_table.hh"
 
 /*------------------------------------------------------------------------------------------------*/
@@ -92,4 +98,347 @@ TEST(unique_table_test, insertion)
   }
 }
 
-/*------------------------------------------------------------------------------------------------*/
\ No newline at end of file
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(unique_table_test, incremental_rehash)
+{
+  sdd::mem::unique_table<foo, true /* incremental rehash */> ut(2);
+  std::vector<const foo*> foos;
+  for (int i = 0; i < 100; ++i)
+  {
+    foos.push_back(&ut(new (ut.allocate(0)) foo(i), 0));
+  }
+  for (int i = 0; i < 100; ++i)
+  {
+    ASSERT_EQ(foos[i], &ut(new (ut.allocate(0)) foo(i), 0));
+  }
+  ASSERT_EQ(100u, ut.stats().size);
+  ASSERT_LT(0u, ut.stats().rehash);
+  for (auto f : foos)
+  {
+    ut.erase(f);
+  }
+  ASSERT_EQ(0u, ut.stats().size);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+namespace {
+
+struct bar
+{
+  sdd::mem::intrusive_member_hook<bar> hook;
+  std::atomic<unsigned int> ref_count_;
+  int i_;
+
+  bar(int i) : ref_count_(0), i_(i) {}
+
+  bool
+  operator==(const bar& other)
+  const noexcept
+  {
+    return i_ == other.i_;
+  }
+
+  void
+  increment_reference_counter()
+  noexcept
+  {
+    ++ref_count_;
+  }
+
+  bool
+  try_increment_reference_counter()
+  noexcept
+  {
+    if (ref_count_++ == 0)
+    {
+      --ref_count_;
+      return false;
+    }
+    return true;
+  }
+
+  bool
+  decrement_reference_counter()
+  noexcept
+  {
+    return --ref_count_ == 0;
+  }
+
+  bool
+  is_not_referenced()
+  const noexcept
+  {
+    return ref_count_ == 0;
+  }
+};
+
+}
+
+namespace std {
+
+template <>
+struct hash<bar>
+{
+  std::size_t
+  operator()(const bar& b)
+  const noexcept
+  {
+    return std::hash<int>()(b.i_);
+  }
+};
+
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(unique_table_test, sharded_insertion)
+{
+  using table_type = sdd::mem::sharded_unique_table<bar, 4>;
+  {
+    table_type ut(100);
+
+    bar* b1_ptr = new (ut.allocate(0)) bar(42);
+    bar& b1 = ut(b1_ptr, 0);
+    ASSERT_EQ(1u, b1.ref_count_);
+
+    bar* b2_ptr = new (ut.allocate(0)) bar(42);
+    bar& b2 = ut(b2_ptr, 0);
+    ASSERT_EQ(&b1, &b2);
+    ASSERT_EQ(2u, b1.ref_count_);
+
+    bar* b3_ptr = new (ut.allocate(0)) bar(43);
+    bar& b3 = ut(b3_ptr, 0);
+    ASSERT_NE(&b1, &b3);
+    ASSERT_EQ(2u, ut.stats().size);
+    ASSERT_EQ(3u, ut.stats().access);
+    ASSERT_EQ(1u, ut.stats().hits);
+
+    b1.decrement_reference_counter();
+    b1.decrement_reference_counter();
+    ut.erase(&b1);
+    b3.decrement_reference_counter();
+    ut.erase(&b3);
+    ASSERT_EQ(0u, ut.stats().size);
+    ASSERT_EQ(2u, ut.stats().peak);
+  }
+  {
+    table_type ut(100);
+
+    bar* b1_ptr = new (ut.allocate(0)) bar(42);
+    bar& b1 = ut(b1_ptr, 0);
+
+    // b1 is no longer referenced, but its erasure has not been processed yet.
+    b1.decrement_reference_counter();
+    bar* b2_ptr = new (ut.allocate(0)) bar(42);
+    bar& b2 = ut(b2_ptr, 0);
+    ASSERT_NE(&b1, &b2);
+    ASSERT_EQ(1u, ut.stats().size);
+
+    ut.erase(&b1);
+    ASSERT_EQ(1u, ut.stats().size);
+    b2.decrement_reference_counter();
+    ut.erase(&b2);
+    ASSERT_EQ(0u, ut.stats().size);
+  }
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(unique_table_test, sharded_concurrent_insertion)
+{
+  static constexpr int nb_threads = 4;
+  static constexpr int nb_values = 1000;
+
+  sdd::mem::sharded_unique_table<bar> ut(100);
+  std::vector<std::vector<bar*>> results(nb_threads);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nb_threads; ++t)
+  {
+    threads.emplace_back([&, t]
+    {
+      for (int round = 0; round < 10; ++round)
+      {
+        for (int i = 0; i < nb_values; ++i)
+        {
+          // Reverse the order of insertions in half of the threads.
+          const auto value = t % 2 ? i : nb_values - i - 1;
+          results[t].push_back(&ut(new (ut.allocate(0)) bar(value), 0));
+        }
+        // Release everything but the last round.
+        if (round != 9)
+        {
+          for (auto b : results[t])
+          {
+            if (b->decrement_reference_counter())
+            {
+              ut.erase(b);
+            }
+          }
+          results[t].clear();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  ASSERT_EQ(static_cast<std::size_t>(nb_values), ut.stats().size);
+  for (int t = 1; t < nb_threads; ++t)
+  {
+    for (int i = 0; i < nb_values; ++i)
+    {
+      const auto j = (t % 2) == 0 ? i : nb_values - i - 1;
+      ASSERT_EQ(results[0][i], results[t][j]);
+    }
+  }
+  for (const auto& result : results)
+  {
+    for (auto b : result)
+    {
+      if (b->decrement_reference_counter())
+      {
+        ut.erase(b);
+      }
+    }
+  }
+  ASSERT_EQ(0u, ut.stats().size);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+/*------------------------------------------------------------------------------------------------*/
+
+namespace {
+
+struct baz
+{
+  static std::size_t nb_hash;
+  int i_;
+
+  baz(int i) : i_(i) {}
+
+  bool
+  operator==(const baz& other)
+  const noexcept
+  {
+    return i_ == other.i_;
+  }
+};
+
+std::size_t baz::nb_hash = 0;
+
+}
+
+namespace std {
+
+template <>
+struct hash<baz>
+{
+  std::size_t
+  operator()(const baz& b)
+  const noexcept
+  {
+    ++baz::nb_hash;
+    return std::hash<int>()(b.i_);
+  }
+};
+
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(unique_table_test, hash_computed_once)
+{
+  using unique_type = sdd::mem::unique<baz>;
+  baz::nb_hash = 0;
+  {
+    // A small initial size to trigger some rehashes.
+    sdd::mem::unique_table<unique_type> ut(2);
+    std::vector<unique_type*> uniques;
+    for (int i = 0; i < 100; ++i)
+    {
+      uniques.push_back(&ut(new (ut.allocate(0)) unique_type(i), 0));
+    }
+    ASSERT_LT(0u, ut.stats().rehash);
+    ASSERT_EQ(&ut(new (ut.allocate(0)) unique_type(42), 0), uniques[42]);
+    for (auto u : uniques)
+    {
+      ut.erase(u);
+    }
+  }
+  ASSERT_EQ(101u, baz::nb_hash);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(unique_table_test, deferred_collection)
+{
+  using unique_type = sdd::mem::unique<baz>;
+  sdd::mem::unique_table<unique_type> ut(100, 3 /* collection threshold */);
+
+  const auto unify = [&](int i) -> unique_type&
+  {
+    auto& u = ut(new (ut.allocate(0)) unique_type(i), 0);
+    u.increment_reference_counter();
+    return u;
+  };
+  const auto release = [&](unique_type& u)
+  {
+    if (u.decrement_reference_counter())
+    {
+      ut.erase(&u);
+    }
+  };
+
+  auto& u0 = unify(0);
+  release(u0);
+  ASSERT_EQ(1u, ut.stats().dead);
+  ASSERT_EQ(1u, ut.stats().size);
+
+  // u0 is resurrected.
+  ASSERT_EQ(&u0, &unify(0));
+  ASSERT_EQ(0u, ut.stats().dead);
+  ASSERT_EQ(1u, ut.stats().resurrected);
+
+  release(u0);
+  release(unify(1));
+  release(unify(2));
+  ASSERT_EQ(3u, ut.stats().dead);
+  ASSERT_EQ(3u, ut.stats().size);
+
+  // The threshold is reached, the next unification triggers a collection.
+  auto& u3 = unify(3);
+  ASSERT_EQ(0u, ut.stats().dead);
+  ASSERT_EQ(1u, ut.stats().size);
+  ASSERT_EQ(3u, ut.stats().collected);
+
+  release(u3);
+  ASSERT_EQ(1u, ut.collect());
+  ASSERT_EQ(0u, ut.stats().size);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(unique_table_test, find_without_construction)
+{
+  using unique_type = sdd::mem::unique<baz>;
+  sdd::mem::unique_table<unique_type> ut(100);
+  const auto is = [](int i){return [i](const baz& b){return b.i_ == i;};};
+
+  auto& u = ut(new (ut.allocate(0)) unique_type(42), 0);
+  baz::nb_hash = 0;
+  ASSERT_EQ(&u, ut.find(std::hash<baz>()(baz(42)), is(42)));
+  ASSERT_EQ(nullptr, ut.find(std::hash<baz>()(baz(43)), is(43)));
+  ASSERT_EQ(2u, baz::nb_hash);
+  ASSERT_EQ(1u, ut.stats().hits);
+
+  // A data constructed with its hash value doesn't compute it again.
+  const auto hash = std::hash<baz>()(baz(43));
+  auto& v = ut(new (ut.allocate(0)) unique_type(sdd::mem::precomputed_hash, hash, 43), 0);
+  ASSERT_EQ(&v, ut.find(hash, is(43)));
+  ut.erase(&u);
+  ut.erase(&v);
+}
@@ -1,4 +1,5 @@
 #include <memory> // unique_ptr
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -13,8 +14,9 @@ struct flat_set_test
   struct conf
   {
     std::size_t flat_set_unique_table_size;
+    std::size_t flat_set_cache_size;
     conf()
-      : flat_set_unique_table_size(100)
+      : flat_set_unique_table_size(100), flat_set_cache_size(100)
     {
     }
   };
@@ -181,3 +183,60 @@ TEST_F(flat_set_test, sum)
 }
 
 /*------------------------------------------------------------------------------------------------*/
+
+TEST_F(flat_set_test, inline_storage)
+{
+  const auto nb_unified = m_.statistics().size;
+  flat_set fs {42};
+  ASSERT_FALSE(fs.unified());
+  ASSERT_EQ(nb_unified, m_.statistics().size);
+  ASSERT_EQ(1u, fs.size());
+  ASSERT_EQ(42u, *fs.begin());
+  ASSERT_EQ(flat_set({42}), fs);
+  ASSERT_NE(flat_set({43}), fs);
+  ASSERT_EQ(std::hash<flat_set>()(flat_set({42})), std::hash<flat_set>()(fs));
+
+  // A set too large to be stored inline is unified, and stored inline again when it shrinks.
+  fs.insert(43);
+  ASSERT_TRUE(fs.unified());
+  ASSERT_EQ(flat_set({42,43}), fs);
+  fs.erase(43);
+  ASSERT_FALSE(fs.unified());
+  ASSERT_EQ(flat_set({42}), fs);
+  ASSERT_EQ(flat_set({42}), difference(flat_set({1,42}), flat_set({1})));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(flat_set_test, cache)
+{
+  const flat_set fs1 {1,2,3};
+  const flat_set fs2 {2,3,5};
+  const auto hits = m_.state.operations_statistics().hits;
+  ASSERT_EQ((flat_set {1,2,3,5}), sum(fs1, fs2));
+  ASSERT_EQ((flat_set {1,2,3,5}), sum(fs2, fs1));
+  ASSERT_EQ(hits + 1, m_.state.operations_statistics().hits);
+  ASSERT_EQ((flat_set {1}), difference(fs1, fs2));
+  ASSERT_EQ((flat_set {5}), difference(fs2, fs1));
+  ASSERT_EQ(hits + 1, m_.state.operations_statistics().hits);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(flat_set_test, builder)
+{
+  flat_set fs {1,2,3};
+  auto builder = fs.builder();
+  builder.erase(2);
+  builder.insert(10);
+  builder.insert(11);
+  ASSERT_EQ((flat_set {1,2,3}), fs);
+  fs = flat_set(std::move(builder));
+  ASSERT_EQ((flat_set {1,3,10,11}), fs);
+
+  const std::vector<unsigned int> values {0, 3, 12};
+  fs.insert(values.begin(), values.end());
+  ASSERT_EQ((flat_set {0,1,3,10,11,12}), fs);
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,156 @@
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/conf/default_configurations.hh"
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/hom/context.hh"
+#include "sdd/hom/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/order/order.hh"
+#include "sdd/values/interval_set.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+using intervals = sdd::values::interval_set<unsigned int>;
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(interval_set_test, construction)
+{
+  ASSERT_TRUE(intervals().empty());
+  ASSERT_EQ(0u, intervals().size());
+  ASSERT_EQ(intervals({{0,2}}), intervals({2,0,1}));
+  ASSERT_EQ(intervals({{0,5}}), intervals({{3,5}, {0,1}, {2,2}}));
+  ASSERT_EQ(intervals({{0,9}, {20,29}}), intervals({{20,29}, {0,4}, {3,9}}));
+  ASSERT_EQ(20u, intervals({{20,29}, {0,4}, {3,9}}).size());
+  ASSERT_EQ(2u, intervals({{20,29}, {0,4}, {3,9}}).intervals().size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(interval_set_test, insertion)
+{
+  intervals s;
+  s.insert(10);
+  s.insert(12);
+  s.insert(11);
+  s.insert(1);
+  s.insert(1);
+  ASSERT_EQ(intervals({{1,1}, {10,12}}), s);
+  ASSERT_EQ(4u, s.size());
+  ASSERT_TRUE(s.contains(11));
+  ASSERT_FALSE(s.contains(9));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(interval_set_test, iteration)
+{
+  const intervals s({{1,3}, {7,8}});
+  ASSERT_EQ(std::vector<unsigned int>({1,2,3,7,8}), std::vector<unsigned int>(s.begin(), s.end()));
+  ASSERT_EQ(intervals().begin(), intervals().end());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(interval_set_test, sum)
+{
+  ASSERT_EQ(intervals({{0,20}}), sum(intervals({{0,9}, {15,20}}), intervals({{10,14}})));
+  ASSERT_EQ(intervals({{0,9}, {15,20}}), sum(intervals({{0,9}}), intervals({{15,20}})));
+  ASSERT_EQ(intervals({{0,30}}), sum(intervals({{0,9}, {20,30}}), intervals({{5,25}})));
+  ASSERT_EQ(intervals({{0,9}}), sum(intervals(), intervals({{0,9}})));
+  const auto max = std::numeric_limits<unsigned int>::max();
+  ASSERT_EQ(intervals({{0,max}}), sum(intervals({{0,9}}), intervals({{10,max}})));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(interval_set_test, intersection)
+{
+  ASSERT_EQ( intervals({{5,9}, {20,25}})
+           , intersection(intervals({{0,9}, {20,30}}), intervals({{5,25}})));
+  ASSERT_EQ(intervals(), intersection(intervals({{0,9}}), intervals({{10,20}})));
+  ASSERT_EQ( intervals({{2,2}, {4,4}})
+           , intersection(intervals({{0,10}}), intervals({{2,2}, {4,4}, {12,15}})));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(interval_set_test, difference)
+{
+  ASSERT_EQ( intervals({{0,4}, {26,30}})
+           , difference(intervals({{0,9}, {20,30}}), intervals({{5,25}})));
+  ASSERT_EQ( intervals({{0,1}, {3,3}, {5,10}})
+           , difference(intervals({{0,10}}), intervals({{2,2}, {4,4}, {12,15}})));
+  ASSERT_EQ(intervals(), difference(intervals({{2,8}}), intervals({{0,10}})));
+  ASSERT_EQ(intervals({{0,9}}), difference(intervals({{0,9}}), intervals({{10,20}})));
+  ASSERT_EQ( intervals({{0,0}, {10,10}, {20,20}})
+           , difference(intervals({{0,10}, {12,20}}), intervals({{1,9}, {11,19}})));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(interval_set_test, shift)
+{
+  using shift = sdd::values::interval_shift<unsigned int>;
+  ASSERT_EQ(intervals({{1,10}, {21,31}}), shift(1)(intervals({{0,9}, {20,30}})));
+  ASSERT_EQ(intervals({{1,9}}), shift(1, 0, 9)(intervals({{0,9}})));
+  ASSERT_EQ(intervals({{0,8}}), shift(-1)(intervals({{0,9}})));
+  ASSERT_EQ(intervals(), shift(-10)(intervals({{0,9}})));
+  ASSERT_TRUE(shift(0, 2, 5).selector());
+  ASSERT_FALSE(shift(1).selector());
+  ASSERT_TRUE(shift(1) == shift(1));
+  ASSERT_FALSE(shift(1) == shift(1, 0, 9));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(interval_set_test, output)
+{
+  std::stringstream ss;
+  ss << intervals({{1,3}, {5,5}, {7,9}});
+  ASSERT_EQ("{1..3,5,7..9}", ss.str());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct interval_set_conf
+  : public sdd::default_configuration
+{
+  using Identifier = unsigned int;
+  using Values     = intervals;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(interval_set_sdd_test, shift_function)
+{
+  using conf   = interval_set_conf;
+  using SDD    = sdd::SDD<conf>;
+  auto m = sdd::init(small_conf<conf>());
+  const auto one = sdd::one<conf>();
+  const sdd::order<conf> o(sdd::order_builder<conf>({1, 0}));
+
+  // A clock and a bounded counter.
+  const SDD s0(1, intervals({{0,9}}), SDD(0, intervals({{0,999999}}), one));
+  const SDD s1(1, intervals({{5,20}}), SDD(0, intervals({{10,10}}), one));
+  const SDD s = s0 + s1;
+  ASSERT_EQ(10000000u + 16 - 5, s.size());
+
+  using shift = sdd::values::interval_shift<unsigned int>;
+  const auto tick = sdd::function(o, 1, shift(1, 0, 20));
+  const auto consume = sdd::function(o, 0, shift(-1));
+  ASSERT_EQ( SDD(1, intervals({{1,10}}), SDD(0, intervals({{0,999999}}), one))
+           + SDD(1, intervals({{6,20}}), SDD(0, intervals({{10,10}}), one))
+           , tick(o, s));
+  ASSERT_EQ( SDD(1, intervals({{0,9}}), SDD(0, intervals({{0,999998}}), one))
+           + SDD(1, intervals({{5,20}}), SDD(0, intervals({{9,9}}), one))
+           , consume(o, s));
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,232 @@
+#include <algorithm> // set_difference, set_intersection, set_union
+#include <iterator>  // inserter
+#include <numeric>   // iota
+#include <random>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/conf/default_configurations.hh"
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/values/roaring.hh"
+#include "sdd/values_manager.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct roaring_test
+  : public testing::Test
+{
+  struct conf
+  {
+    std::size_t roaring_unique_table_size;
+    conf()
+      : roaring_unique_table_size(100)
+    {
+    }
+  };
+
+  using roaring = sdd::values::roaring;
+  using kind = sdd::values::roaring_container::kind;
+  sdd::values_manager<roaring> m_;
+
+  roaring_test()
+    : m_(conf())
+  {
+    *sdd::global_values_ptr<roaring>() = &m_;
+  }
+
+  ~roaring_test()
+  {
+    *sdd::global_values_ptr<roaring>() = nullptr;
+  }
+
+  /// @brief Values in every representation: sparse, dense and consecutive.
+  static
+  std::set<unsigned int>
+  random_values(unsigned int seed)
+  {
+    std::mt19937 gen(seed);
+    std::set<unsigned int> res;
+    std::uniform_int_distribution<unsigned int> sparse(0, 1 << 20);
+    for (auto i = 0; i < 2000; ++i)
+    {
+      res.insert(sparse(gen));
+    }
+    std::uniform_int_distribution<unsigned int> dense(1 << 21, (1 << 21) + 20000);
+    for (auto i = 0; i < 8000; ++i)
+    {
+      res.insert(dense(gen));
+    }
+    const auto start = (3u << 20) + seed * 100;
+    for (auto i = start; i < start + 30000; ++i)
+    {
+      res.insert(i);
+    }
+    return res;
+  }
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, empty)
+{
+  ASSERT_TRUE(roaring().empty());
+  ASSERT_EQ(0u, roaring().size());
+  ASSERT_FALSE(roaring({1 << 30}).empty());
+  ASSERT_TRUE(difference(roaring({1, 1 << 30}), roaring({1, 1 << 30})).empty());
+  ASSERT_EQ(roaring(), difference(roaring({1, 1 << 30}), roaring({1, 1 << 30})));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, insertion)
+{
+  roaring r;
+  r.insert(70000);
+  r.insert(1);
+  r.insert(42);
+  r.insert(1);
+  ASSERT_EQ(roaring({1,42,70000}), r);
+  ASSERT_EQ(3u, r.size());
+  ASSERT_TRUE(r.contains(70000));
+  ASSERT_FALSE(r.contains(70001));
+  ASSERT_EQ(2u, r.containers().size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, representations)
+{
+  std::vector<unsigned int> runs;
+  std::vector<unsigned int> dense;
+  std::vector<unsigned int> sparse;
+  for (unsigned int i = 0; i < 10000; ++i)
+  {
+    runs.push_back(i);
+    dense.push_back((1 << 16) + 2 * i);
+  }
+  for (unsigned int i = 0; i < 3000; ++i)
+  {
+    sparse.push_back((2 << 16) + 5 * i);
+  }
+  std::vector<unsigned int> values(runs);
+  values.insert(values.end(), dense.begin(), dense.end());
+  values.insert(values.end(), sparse.begin(), sparse.end());
+
+  const roaring r(values.begin(), values.end());
+  ASSERT_EQ(23000u, r.size());
+  ASSERT_EQ(3u, r.containers().size());
+  ASSERT_EQ(kind::run, r.containers()[0].representation());
+  ASSERT_EQ(kind::bitmap, r.containers()[1].representation());
+  ASSERT_EQ(kind::array, r.containers()[2].representation());
+
+  // The representation only depends on values.
+  const auto less_dense = difference(r, roaring(dense.begin() + 1000, dense.end()));
+  ASSERT_EQ(14000u, less_dense.size());
+  ASSERT_EQ(kind::array, less_dense.containers()[1].representation());
+  values = runs;
+  values.insert(values.end(), dense.begin(), dense.begin() + 1000);
+  values.insert(values.end(), sparse.begin(), sparse.end());
+  ASSERT_EQ(roaring(values.begin(), values.end()), less_dense);
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, iteration)
+{
+  const auto ref = random_values(0);
+  const roaring r(ref.begin(), ref.end());
+  ASSERT_EQ(ref.size(), r.size());
+  ASSERT_TRUE(std::equal(ref.begin(), ref.end(), r.begin()));
+  ASSERT_EQ(ref.size(), static_cast<std::size_t>(std::distance(r.begin(), r.end())));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, operations)
+{
+  const auto lhs_ref = random_values(1);
+  const auto rhs_ref = random_values(2);
+  const roaring lhs(lhs_ref.begin(), lhs_ref.end());
+  const roaring rhs(rhs_ref.begin(), rhs_ref.end());
+
+  std::set<unsigned int> ref;
+  std::set_union( lhs_ref.begin(), lhs_ref.end(), rhs_ref.begin(), rhs_ref.end()
+                , std::inserter(ref, ref.end()));
+  ASSERT_EQ(roaring(ref.begin(), ref.end()), sum(lhs, rhs));
+  ASSERT_EQ(ref.size(), sum(lhs, rhs).size());
+
+  ref.clear();
+  std::set_intersection( lhs_ref.begin(), lhs_ref.end(), rhs_ref.begin(), rhs_ref.end()
+                       , std::inserter(ref, ref.end()));
+  ASSERT_EQ(roaring(ref.begin(), ref.end()), intersection(lhs, rhs));
+
+  ref.clear();
+  std::set_difference( lhs_ref.begin(), lhs_ref.end(), rhs_ref.begin(), rhs_ref.end()
+                     , std::inserter(ref, ref.end()));
+  ASSERT_EQ(roaring(ref.begin(), ref.end()), difference(lhs, rhs));
+
+  ASSERT_EQ(lhs, sum(lhs, lhs));
+  ASSERT_EQ(lhs, intersection(lhs, lhs));
+  ASSERT_EQ(lhs, sum(difference(lhs, rhs), intersection(lhs, rhs)));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, hash)
+{
+  const auto ref = random_values(3);
+  const roaring r(ref.begin(), ref.end());
+  const roaring r2 = sum(roaring(ref.begin(), std::next(ref.begin(), 100)), r);
+  ASSERT_EQ(r, r2);
+  ASSERT_EQ(std::hash<roaring>()(r), std::hash<roaring>()(r2));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST_F(roaring_test, output)
+{
+  std::stringstream ss;
+  ss << roaring({1,2,3,5,70000});
+  ASSERT_EQ("{1..3,5,70000}", ss.str());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+struct roaring_conf
+  : public sdd::roaring_default_configuration
+{
+  using Identifier = unsigned int;
+  using Values     = sdd::values::roaring;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(roaring_sdd_test, operations)
+{
+  using SDD    = sdd::SDD<roaring_conf>;
+  using values = sdd::values::roaring;
+  auto m = sdd::init(small_conf<roaring_conf>());
+  const auto one = sdd::one<roaring_conf>();
+
+  const SDD x(1, values{0, 1 << 20}, SDD(0, values{1 << 30}, one));
+  const SDD y(1, values{1 << 20, 7}, SDD(0, values{3}, one));
+
+  const SDD xy = x + y;
+  ASSERT_EQ(4u, xy.size());
+  ASSERT_EQ(x, xy - y);
+  ASSERT_EQ(y, xy & y);
+  ASSERT_LT(0u, m.values_stats().size);
+
+  std::vector<unsigned int> many(100000);
+  std::iota(many.begin(), many.end(), 0);
+  ASSERT_EQ(100000u, SDD(0, values(many.begin(), many.end()), one).size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
@@ -0,0 +1,160 @@
+#include <sstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "sdd/conf/default_configurations.hh"
+#include "sdd/dd/context.hh"
+#include "sdd/dd/definition.hh"
+#include "sdd/manager.hh"
+#include "sdd/values/wide_bitset.hh"
+
+#include "tests/configuration.hh"
+
+/*------------------------------------------------------------------------------------------------*/
+
+template <typename Bitset>
+struct wide_bitset_test
+  : public testing::Test
+{
+  using bitset = Bitset;
+};
+
+using wide_bitsets = ::testing::Types<sdd::values::wide_bitset<1000>, sdd::values::dynamic_bitset>;
+TYPED_TEST_CASE(wide_bitset_test, wide_bitsets);
+
+#define bitset typename TestFixture::bitset
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(wide_bitset_test, empty)
+{
+  ASSERT_TRUE(bitset().empty());
+  ASSERT_FALSE(bitset({999}).empty());
+  ASSERT_TRUE(difference(bitset({999}), bitset({999})).empty());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(wide_bitset_test, insertion)
+{
+  bitset b;
+  b.insert(1);
+  b.insert(300);
+  b.insert(999);
+  ASSERT_EQ(bitset({1,300,999}), b);
+  ASSERT_TRUE(b.test(300));
+  ASSERT_FALSE(b.test(301));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(wide_bitset_test, size)
+{
+  ASSERT_EQ(0u, bitset({}).size());
+  ASSERT_EQ(4u, bitset({0,63,64,999}).size());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(wide_bitset_test, iteration)
+{
+  const std::vector<std::size_t> values {0, 5, 63, 64, 127, 128, 500, 998, 999};
+  bitset b;
+  for (auto v : values)
+  {
+    b.insert(v);
+  }
+  ASSERT_EQ(values, std::vector<std::size_t>(b.begin(), b.end()));
+  ASSERT_TRUE(bitset().begin() == bitset().end());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(wide_bitset_test, order)
+{
+  ASSERT_FALSE(bitset({1}) < bitset({1}));
+  ASSERT_TRUE(bitset({1}) < bitset({999}) or bitset({999}) < bitset({1}));
+  ASSERT_TRUE(bitset({1, 999}) < bitset({2, 999}) or bitset({2, 999}) < bitset({1, 999}));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(wide_bitset_test, sum)
+{
+  ASSERT_EQ(bitset(),          sum(bitset(), bitset()));
+  ASSERT_EQ(bitset({0}),       sum(bitset({0}), bitset()));
+  ASSERT_EQ(bitset({0,999}),   sum(bitset({0}), bitset({999})));
+  ASSERT_EQ(bitset({0,1,999}), sum(bitset({0,999}), bitset({0,1})));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(wide_bitset_test, intersection)
+{
+  ASSERT_EQ(bitset(),        intersection(bitset(), bitset()));
+  ASSERT_EQ(bitset(),        intersection(bitset({0}), bitset({999})));
+  ASSERT_EQ(bitset({999}),   intersection(bitset({0,999}), bitset({999})));
+  ASSERT_EQ(bitset({0,700}), intersection(bitset({0,300,700}), bitset({0,700,999})));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(wide_bitset_test, difference)
+{
+  ASSERT_EQ(bitset(),          difference(bitset(), bitset()));
+  ASSERT_EQ(bitset({0}),       difference(bitset({0}), bitset({999})));
+  ASSERT_EQ(bitset({0}),       difference(bitset({0,999}), bitset({999})));
+  ASSERT_EQ(bitset({300,999}), difference(bitset({0,300,999}), bitset({0,700})));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(wide_bitset_test, hash)
+{
+  std::hash<bitset> h;
+  ASSERT_EQ(h(bitset({0,999})), h(sum(bitset({0}), bitset({999}))));
+  ASSERT_EQ(h(bitset({0})), h(difference(bitset({0,999}), bitset({999}))));
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+TYPED_TEST(wide_bitset_test, output)
+{
+  std::stringstream ss;
+  ss << bitset({0,64,999});
+  ASSERT_EQ("{0,64,999}", ss.str());
+}
+
+/*------------------------------------------------------------------------------------------------*/
+
+#undef bitset
+
+struct wide_bitset_conf
+  : public sdd::default_configuration
+{
+  using Identifier = unsigned int;
+  using Values     = sdd::values::dynamic_bitset;
+};
+
+/*------------------------------------------------------------------------------------------------*/
+
+TEST(wide_bitset_sdd_test, operations)
+{
+  using SDD    = sdd::SDD<wide_bitset_conf>;
+  using values = sdd::values::dynamic_bitset;
+  auto m = sdd::init(small_conf<wide_bitset_conf>());
+  const auto one = sdd::one<wide_bitset_conf>();
+
+  const SDD x(1, values{0, 200}, SDD(0, values{1000}, one));
+  const SDD y(1, values{200, 300}, SDD(0, values{2000}, one));
+
+  const SDD xy = x + y;
+  ASSERT_EQ(4u, xy.size());
+  ASSERT_EQ(x, xy - y);
+  ASSERT_EQ(y, xy & y);
+  ASSERT_EQ( SDD(1, values{200}, SDD(0, values{1000, 2000}, one))
+           , xy - SDD(1, values{0, 300}, SDD(0, values{1000, 2000}, one)));
+}
+
+/*------------------------------------------------------------------------------------------------*/